@@ -0,0 +1,765 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../test_1/cfs.h"
+#include "../test_1/compare.h"
+#include "../test_1/engine.h"
+#include "../test_1/generator.h"
+#include "../test_1/histogram.h"
+#include "../test_1/mlfq.h"
+#include "../test_1/multicore.h"
+#include "../test_1/pcb.h"
+#include "../test_1/policies.h"
+#include "process_table.h"
+#include "../test_1/proportional.h"
+#include "../test_1/realtime.h"
+#include "../test_1/rr.h"
+#include "../test_1/sweep.h"
+#include "../test_1/timeline.h"
+#include "../test_1/workload.h"
+#include "../test_1/scheduling.h"
+
+// ԭʵ֣ҵһ̣Ȼ
+static void sort_scheduling_step(std::vector<PCB>& process_list) {
+	for (auto& process : process_list) {
+		if (process.state == State::R) {
+			process.run_process();
+			break;
+		}
+	}
+	std::sort(process_list.begin(), process_list.end(),
+		[](const PCB& a, const PCB& b) { return a.priority > b.priority; });
+}
+
+static std::vector<PCB> make_processes(size_t n) {
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<> dist_priority(1, 5);
+	std::uniform_int_distribution<> dist_time(1, 5);
+
+	std::vector<PCB> process_list;
+	process_list.reserve(n);
+	for (size_t i = 0; i < n; ++i) {
+		process_list.emplace_back(static_cast<int32_t>(i + 1), dist_priority(gen), dist_time(gen), 0, State::R);
+	}
+	return process_list;
+}
+
+template <typename F>
+static double ns_per_tick(size_t ticks, F&& step) {
+	auto begin = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < ticks; ++i) step();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - begin).count() / ticks;
+}
+
+static void bench_ready_queue() {
+	std::printf("priority_scheduling_step: sort vs indexed heap\n");
+	std::printf("%10s %16s %16s %10s\n", "processes", "sort ns/tick", "heap ns/tick", "speedup");
+
+	for (size_t n : { size_t(1000), size_t(100000), size_t(1000000) }) {
+		// ÿ O(n log n)ģС̫
+		size_t sort_ticks = std::max<size_t>(10, 10000000 / n);
+		size_t heap_ticks = n; // ÿһλn ڶѲ
+
+		std::vector<PCB> sorted_list = make_processes(n);
+		double sort_ns = ns_per_tick(sort_ticks, [&] { sort_scheduling_step(sorted_list); });
+
+		std::vector<PCB> process_list = make_processes(n);
+		ReadyQueue ready_queue;
+		build_ready_queue(process_list, ready_queue);
+		ProcessStatus status = count_processes(process_list);
+		double heap_ns = ns_per_tick(heap_ticks, [&] { priority_scheduling_step(process_list, ready_queue, status); });
+
+		std::printf("%10zu %16.1f %16.1f %9.0fx\n", n, sort_ns, heap_ns, sort_ns / heap_ns);
+	}
+}
+
+// ɵʱȷֲܷʱ䣬֡ƽҪ֡
+static double_t make_workload(std::vector<PCB>& process_list, size_t n, int max_burst, double_t mean_gap) {
+	std::mt19937 gen(7);
+	std::uniform_int_distribution<> dist_priority(1, 5);
+	std::uniform_int_distribution<> dist_time(1, max_burst);
+	std::exponential_distribution<> dist_gap(1.0 / mean_gap);
+
+	process_list.clear();
+	process_list.reserve(n);
+	double_t arrival = 0, total = 0;
+	for (size_t i = 0; i < n; ++i) {
+		process_list.emplace_back(static_cast<int32_t>(i + 1), dist_priority(gen), dist_time(gen), 0, State::R, arrival);
+		total += process_list.back().all_time;
+		arrival += std::floor(dist_gap(gen));
+	}
+	return total;
+}
+
+static void bench_event_engine() {
+	std::printf("\nevent-driven Simulator + PriorityScheduler\n");
+	std::printf("%10s %10s %14s %12s %10s\n", "processes", "max burst", "time units", "events", "seconds");
+
+	struct Case { size_t n; int max_burst; double_t mean_gap; };
+	for (Case c : { Case{ 1000000, 5, 4 }, Case{ 1000000, 1000, 2000 } }) {
+		std::vector<PCB> process_list;
+		double_t units = make_workload(process_list, c.n, c.max_burst, c.mean_gap);
+
+		PriorityScheduler scheduler;
+		auto begin = std::chrono::steady_clock::now();
+		Simulator sim(process_list, scheduler);
+		sim.run();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		std::printf("%10zu %10d %14.0f %12zu %10.2f\n", c.n, c.max_burst, units, sim.stats().events, seconds);
+	}
+}
+
+// ͬһطֱãSimulator + Scheduler&Ͱʵ棬Ƚÿ¼ĺʱ
+template <typename Policy>
+static void static_dispatch_case(const std::vector<PCB>& workload, double_t& virtual_ns, double_t& static_ns, size_t& events) {
+	auto measure = [&](auto&& run) {
+		double best = 1e300;
+		for (int rep = 0; rep < 3; ++rep) {
+			std::vector<PCB> process_list = workload;
+			Policy scheduler;
+			auto begin = std::chrono::steady_clock::now();
+			events = run(process_list, scheduler);
+			best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+		}
+		return best * 1e9 / events;
+	};
+	virtual_ns = measure([](std::vector<PCB>& process_list, Policy& scheduler) {
+		Simulator sim(process_list, static_cast<Scheduler&>(scheduler));
+		sim.run();
+		return sim.stats().events;
+		});
+	static_ns = measure([](std::vector<PCB>& process_list, Policy& scheduler) {
+		BasicSimulator<Policy> sim(process_list, scheduler);
+		sim.run();
+		return sim.stats().events;
+		});
+}
+
+static void bench_static_dispatch() {
+	std::printf("\nvirtual Scheduler& vs BasicSimulator<Policy> (500k processes, bursts 1-5, best of 3)\n");
+	std::printf("%10s %12s %12s %12s %10s\n", "policy", "events", "virtual ns", "static ns", "speedup");
+
+	std::vector<PCB> workload;
+	make_workload(workload, 500000, 5, 4);
+
+	auto row = [](const char* name, size_t events, double_t virtual_ns, double_t static_ns) {
+		std::printf("%10s %12zu %12.1f %12.1f %9.2fx\n", name, events, virtual_ns, static_ns, virtual_ns / static_ns);
+	};
+	double_t virtual_ns = 0, static_ns = 0;
+	size_t events = 0;
+	static_dispatch_case<MlfqScheduler>(workload, virtual_ns, static_ns, events);
+	row("MLFQ", events, virtual_ns, static_ns);
+	static_dispatch_case<PriorityScheduler>(workload, virtual_ns, static_ns, events);
+	row("Priority", events, virtual_ns, static_ns);
+	static_dispatch_case<RoundRobinScheduler>(workload, virtual_ns, static_ns, events);
+	row("RR", events, virtual_ns, static_ns);
+	static_dispatch_case<CfsScheduler>(workload, virtual_ns, static_ns, events);
+	row("CFS", events, virtual_ns, static_ns);
+}
+
+// ¼ͬһأʽ¼ͼ¼¼ + ʱĹؼ֡ߴȡã
+// ¼ļʱ set_recorder ĵһؼ֡ǽӲֵӰбؼ֡ĺʱռ¼ʱı
+//  20 λƽطźʱ
+// λÿؼ֮֡ǰһ¼ӵ֡ࡢطһȡ
+static void bench_recording() {
+	std::printf("\nrecording overhead and scrub latency (1M processes streamed, bursts 1-5, event ring 64k, best of 7)\n");
+	std::printf("%10s %12s %10s %10s %10s %10s %10s %10s %10s %12s %12s\n", "policy", "events", "plain s", "record s", "overhead",
+		"kf save", "keyframes", "deltas", "kf MB", "avg seek ms", "max seek ms");
+
+	std::vector<PCB> workload;
+	make_workload(workload, 1000000, 5, 3);
+	SharedWorkload shared = share_workload(std::move(workload));
+	using clock = std::chrono::steady_clock;
+
+	for (const char* name : { "priority", "rr", "cfs" }) {
+		double plain = 1e300, recorded = 1e300, saving = 1e300;
+		SimRecorder recorder;
+		for (int rep = 0; rep < 7; ++rep) {
+			for (bool record : { false, true }) {
+				SharedSource source(shared);
+				std::vector<PCB> slots;
+				std::unique_ptr<AnySimulator> sim = make_simulator(name, PolicyConfig(), slots, SimConfig(), &source);
+				recorder.clear(); // ͷһֵļ¼һ
+				auto begin = clock::now();
+				if (record) sim->set_recorder(&recorder);
+				sim->run();
+				double seconds = std::chrono::duration<double>(clock::now() - begin).count();
+				(record ? recorded : plain) = std::min(record ? recorded : plain, seconds);
+				if (record) saving = std::min(saving, recorder.keyframes.spent_seconds());
+			}
+		}
+
+		auto seek = [&](uint64_t index) {
+			SharedSource source(shared);
+			std::vector<PCB> slots;
+			std::unique_ptr<AnySimulator> view = make_simulator(name, PolicyConfig(), slots, SimConfig(), &source);
+			auto begin = clock::now();
+			replay_to(recorder, *view, index);
+			return std::chrono::duration<double>(clock::now() - begin).count() * 1e3;
+		};
+		std::mt19937_64 gen(1);
+		double total_ms = 0, max_ms = 0;
+		for (int i = 0; i < 20; ++i) total_ms += seek(std::uniform_int_distribution<uint64_t>(0, recorder.events.size())(gen));
+		size_t deltas = 0;
+		for (const Keyframe* k = recorder.keyframes.oldest(); k <= recorder.keyframes.newest(); ++k) {
+			deltas += !k->full;
+			uint64_t next = k < recorder.keyframes.newest() ? (k + 1)->index : recorder.events.size() + 1;
+			max_ms = std::max(max_ms, seek(next - 1));
+		}
+		std::printf("%10s %12llu %10.3f %10.3f %9.1f%% %9.1f%% %10zu %10zu %10.0f %12.1f %12.1f\n", name,
+			static_cast<unsigned long long>(recorder.events.size()), plain, recorded, 100 * (recorded / plain - 1),
+			100 * saving / plain, recorder.keyframes.size(), deltas, recorder.keyframes.memory_bytes() / 1048576.0, total_ms / 20, max_ms);
+	}
+}
+
+static void bench_io_mix() {
+	std::printf("\nCPU / I/O mix, 1000000 processes, RR q=1, 2 exponential devices, I/O every 1 for 4 on average\n");
+	std::printf("%10s %12s %12s %12s %12s %10s\n", "io_bound", "events", "cpu util", "io util", "ns/event", "seconds");
+	for (double_t io_bound : { 0.0, 0.1, 0.3 }) {
+		std::vector<PCB> process_list = random_workload(1000000, 1, 4);
+		IoMix mix;
+		mix.io_bound = io_bound;
+		mix.devices = 2;
+		assign_io(process_list, mix, 1);
+
+		SimConfig config;
+		config.devices.assign(2, DeviceConfig());
+		RrConfig rr;
+		rr.quantum = 1;
+		RoundRobinScheduler scheduler(rr);
+		auto begin = std::chrono::steady_clock::now();
+		Simulator sim(process_list, scheduler, config);
+		sim.run();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		const SimStats& stats = sim.stats();
+		std::printf("%10.1f %12zu %12.3f %12.3f %12.1f %10.2f\n", io_bound, stats.events, stats.utilization(),
+			stats.io_utilization(2), seconds * 1e9 / stats.events, seconds);
+	}
+}
+
+static void bench_generator() {
+	const uint64_t n = 10000000;
+	std::printf("\nWorkloadGenerator, %llu processes per distribution, mean burst 3\n", static_cast<unsigned long long>(n));
+	std::printf("%10s %12s %12s %12s\n", "burst", "sample mean", "max", "ns/process");
+	for (BurstDistribution burst : { BurstDistribution::Uniform, BurstDistribution::Exponential, BurstDistribution::Pareto,
+		BurstDistribution::LogNormal, BurstDistribution::Bimodal }) {
+		GeneratorConfig config;
+		config.processes = n;
+		config.burst = burst;
+		WorkloadGenerator generator(config);
+		PCB process(0, 0, 0, 0, State::R);
+		double sum = 0, max = 0;
+		auto begin = std::chrono::steady_clock::now();
+		while (generator.next(process)) {
+			sum += process.burst;
+			max = std::max(max, process.burst);
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		std::printf("%10s %12.3f %12.1f %12.1f\n", burst_distribution_name(burst), sum / n, max, seconds * 1e9 / n);
+	}
+
+	// ʽģ⣺ֻ̱ϵͳеĽ
+	GeneratorConfig config;
+	config.processes = n;
+	config.burst = BurstDistribution::Pareto;
+	config.arrival_rate = 0.3;
+	WorkloadGenerator generator(config);
+	std::vector<PCB> slots;
+	RrConfig rr;
+	rr.quantum = 2;
+	RoundRobinScheduler scheduler(rr);
+	auto begin = std::chrono::steady_clock::now();
+	Simulator sim(slots, scheduler, generator);
+	sim.run();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	std::printf("streaming RR over Pareto(1.5) at load 0.9: %zu finished, %zu slots, p99 response %.1f, %.2f s\n",
+		sim.stats().finished, slots.size(), sim.latency().response.percentile(99), seconds);
+}
+
+static void bench_multicore() {
+	std::printf("\nMultiCoreSim: per-core run queues + work stealing (1M processes)\n");
+	std::printf("%6s %8s %12s %10s %10s %12s %10s %10s\n",
+		"cores", "threads", "makespan", "avg util", "imbalance", "migrations", "steals", "seconds");
+
+	for (int32_t n_cores : { 1, 8, 64 }) {
+		for (int32_t threads : { 1, 0 }) {
+			std::vector<PCB> process_list;
+			make_workload(process_list, 1000000, 100, 50.0 / n_cores);
+
+			MultiCoreConfig config;
+			config.cores = n_cores;
+			config.threads = threads;
+			auto begin = std::chrono::steady_clock::now();
+			MultiCoreSim sim(process_list, config);
+			sim.run();
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+			const MultiCoreStats& stats = sim.stats();
+			double_t util = 0;
+			for (size_t i = 0; i < stats.cores.size(); ++i) util += stats.utilization(i);
+			std::printf("%6d %8d %12.0f %10.3f %10.3f %12zu %10zu %10.2f\n", n_cores, threads, stats.now,
+				util / stats.cores.size(), stats.load_imbalance(), stats.migrations, stats.steals, seconds);
+		}
+	}
+}
+
+static void bench_affinity() {
+	std::printf("\nMultiCoreSim cache affinity: 8 cores at load ~0.75, 100k processes, cache 1024, footprint 256, refill 0.002/unit\n");
+	std::printf("%10s %10s %12s %12s %10s %12s %12s %12s\n", "placement", "threshold", "makespan", "throughput",
+		"avg wait", "migrations", "warm-up", "migr. penalty");
+
+	struct Case { Placement placement; int32_t threshold; };
+	for (Case c : { Case{ Placement::Naive, 1 }, Case{ Placement::Affinity, 2 }, Case{ Placement::Affinity, 4 }, Case{ Placement::Affinity, 8 } }) {
+		// ʱ 10~50ƽ 5
+		std::vector<PCB> process_list = random_workload(100000, 1, 5);
+		for (auto& process : process_list) process.all_time = process.burst = process.burst * 10;
+
+		MultiCoreConfig config;
+		config.cores = 8;
+		config.threads = 1;
+		config.epoch = 1;
+		config.placement = c.placement;
+		config.steal_threshold = c.threshold;
+		config.cache_size = 1024;
+		config.footprint = 256;
+		config.refill_cost = 0.002;
+		MultiCoreSim sim(process_list, config);
+		sim.run();
+
+		const MultiCoreStats& stats = sim.stats();
+		std::printf("%10s %10d %12.0f %12.5f %10.2f %12zu %12.0f %12.0f\n", c.placement == Placement::Naive ? "naive" : "affinity",
+			c.threshold, stats.now, stats.throughput(), stats.avg_waiting(), stats.migrations, stats.warmup_time, stats.migration_penalty);
+	}
+}
+
+static void bench_cfs() {
+	std::printf("\nCFS vs Priority (100k processes runnable at t=0, bursts 1-100)\n");
+	std::printf("%10s %14s %12s %12s %10s %12s %10s\n",
+		"policy", "avg turnaround", "avg waiting", "avg response", "fairness", "throughput", "seconds");
+
+	std::vector<PCB> workload;
+	make_workload(workload, 100000, 100, 0.001); // ȫ 0 ʱ̵10 ͬʱ
+
+	PriorityScheduler priority;
+	CfsScheduler cfs;
+	for (Scheduler* scheduler : { static_cast<Scheduler*>(&priority), static_cast<Scheduler*>(&cfs) }) {
+		std::vector<PCB> process_list = workload;
+		auto begin = std::chrono::steady_clock::now();
+		Simulator sim(process_list, *scheduler);
+		sim.run();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		const SimStats& stats = sim.stats();
+		std::printf("%10s %14.1f %12.1f %12.1f %10.3f %12.5f %10.2f\n", scheduler->name(), stats.avg_turnaround(),
+			stats.avg_waiting(), stats.avg_response(), slowdown_fairness(process_list), stats.finished / stats.now, seconds);
+	}
+}
+
+static void bench_sjf() {
+	std::printf("\nSJF / SRTF vs Priority (100k processes, bursts 1-20, mean gap 12, half I/O-bound every 1 for 4, 2 devices)\n");
+	std::printf("%10s %10s %6s %10s %12s %10s %12s %12s %10s\n",
+		"policy", "estimate", "alpha", "error cv", "avg waiting", "vs prio", "p99 waiting", "avg response", "seconds");
+
+	std::vector<PCB> workload;
+	make_workload(workload, 100000, 20, 12);
+	IoMix mix;
+	mix.io_bound = 0.5;
+	mix.devices = 2;
+	assign_io(workload, mix, 1);
+	SimConfig config;
+	config.devices.assign(2, DeviceConfig());
+
+	struct Case {
+		const char* policy;
+		bool predict;
+		double_t alpha;
+		double_t error_cv;
+	};
+	const Case cases[] = {
+		{ "priority", false, 0, 0 }, { "rr", false, 0, 0 },
+		{ "sjf", false, 0, 0 }, { "srtf", false, 0, 0 },
+		{ "srtf", false, 0, 0.5 }, { "srtf", false, 0, 1 }, { "srtf", false, 0, 2 },
+		{ "sjf", true, 0.5, 0 }, { "srtf", true, 0.5, 0 }, { "srtf", true, 0.2, 0 }, { "srtf", true, 0.8, 0 },
+	};
+	double_t baseline = 0;
+	for (const Case& c : cases) {
+		PolicyConfig policies;
+		policies.sjf.predict = c.predict;
+		policies.sjf.alpha = c.alpha;
+		policies.sjf.error_cv = c.error_cv;
+		std::vector<PCB> process_list = workload;
+		auto begin = std::chrono::steady_clock::now();
+		std::unique_ptr<AnySimulator> sim = make_simulator(c.policy, policies, process_list, config);
+		sim->run();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		const SimStats& stats = sim->stats();
+		if (baseline == 0) baseline = stats.avg_waiting();
+		bool sjf = c.policy[0] == 's';
+		std::printf("%10s %10s %6s %10.1f %12.1f %9.1f%% %12.1f %12.1f %10.2f\n", c.policy,
+			!sjf ? "-" : c.predict ? "ewma" : "exact", c.predict ? std::to_string(c.alpha).substr(0, 3).c_str() : "-",
+			c.error_cv, stats.avg_waiting(), 100 * (stats.avg_waiting() / baseline - 1),
+			sim->latency().waiting.percentile(99), stats.avg_response(), seconds);
+	}
+}
+
+static void bench_round_robin() {
+	const double_t switch_cost = 0.1;
+	std::printf("\nRound-robin quantum sweep (20k processes, bursts 1-20, context switch cost %.1f)\n", switch_cost);
+	std::printf("%8s %14s %12s %12s %12s %12s %10s\n",
+		"quantum", "avg turnaround", "avg response", "throughput", "switches", "switch time", "seconds");
+
+	std::vector<PCB> workload;
+	make_workload(workload, 20000, 20, 12);
+
+	SimConfig config;
+	config.context_switch = switch_cost;
+	for (double_t quantum : { 0.5, 1.0, 2.0, 4.0, 8.0, 16.0 }) {
+		RrConfig rr;
+		rr.quantum = quantum;
+		RoundRobinScheduler scheduler(rr);
+		std::vector<PCB> process_list = workload;
+		auto begin = std::chrono::steady_clock::now();
+		Simulator sim(process_list, scheduler, config);
+		sim.run();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		const SimStats& stats = sim.stats();
+		std::printf("%8.1f %14.1f %12.1f %12.5f %12zu %12.1f %10.3f\n", quantum, stats.avg_turnaround(),
+			stats.avg_response(), stats.throughput(), stats.context_switches, stats.switch_time, seconds);
+	}
+}
+
+// ȫ̴ 0 ʱһֱһʱȽÿʵʵõ CPU ݶƱĿݶ
+static void bench_proportional_share() {
+	const size_t n = 100000;
+	const double_t horizon = 1e7; //ƽÿԼ 100 ʱƬ
+	std::printf("\nStride vs Lottery share accuracy (%zu processes, tickets 1-5, quantum 1, %.0e time units)\n", n, horizon);
+	std::printf("%10s %16s %16s %16s %10s\n", "policy", "mean |err|", "max |err|", "class err", "seconds");
+
+	std::vector<PCB> workload = make_processes(n);
+	for (auto& process : workload) {
+		process.all_time = 1e12;
+		process.burst = process.all_time;
+	}
+	int64_t total_tickets = 0;
+	int64_t class_tickets[6] = {};
+	for (const auto& process : workload) {
+		total_tickets += tickets_of(process);
+		class_tickets[tickets_of(process)] += tickets_of(process);
+	}
+
+	StrideScheduler stride;
+	LotteryScheduler lottery;
+	for (Scheduler* scheduler : { static_cast<Scheduler*>(&stride), static_cast<Scheduler*>(&lottery) }) {
+		std::vector<PCB> process_list = workload;
+		auto begin = std::chrono::steady_clock::now();
+		Simulator sim(process_list, *scheduler);
+		sim.run_until(horizon);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		// ΪĿݶıclass err ǰƱܷݶ
+		double_t total_cpu = 0;
+		double_t class_cpu[6] = {};
+		for (const auto& process : process_list) {
+			total_cpu += process.cpu_time;
+			class_cpu[tickets_of(process)] += process.cpu_time;
+		}
+		double_t sum_err = 0, max_err = 0, class_err = 0;
+		for (const auto& process : process_list) {
+			double_t target = static_cast<double_t>(tickets_of(process)) / total_tickets;
+			double_t err = std::abs(process.cpu_time / total_cpu - target) / target;
+			sum_err += err;
+			max_err = std::max(max_err, err);
+		}
+		for (int t = 1; t <= 5; ++t) {
+			if (class_tickets[t] == 0) continue;
+			double_t target = static_cast<double_t>(class_tickets[t]) / total_tickets;
+			class_err = std::max(class_err, std::abs(class_cpu[t] / total_cpu - target) / target);
+		}
+		std::printf("%10s %15.2f%% %15.2f%% %15.3f%% %10.2f\n", scheduler->name(),
+			100 * sum_err / n, 100 * max_err, 100 * class_err, seconds);
+	}
+}
+
+static void bench_realtime() {
+	//  2e8 񼯣ģ 20 
+	std::vector<PeriodicTask> tasks;
+	const double_t periods[] = { 2560, 12500, 20000, 31250, 390625, 1000000 };
+	const double_t wcets[] = { 300, 1500, 2000, 3000, 20000, 40000 };
+	for (int i = 0; i < 6; ++i) {
+		PeriodicTask task;
+		task.pid = i + 1;
+		task.period = periods[i];
+		task.wcet = wcets[i] * 1.5; //U  0.79 6  Liu-Layland 
+		tasks.push_back(task);
+	}
+	Schedulability analysis = analyze(tasks);
+	std::printf("\nReal-time EDF/RMS (6 tasks, U = %.3f, LL bound %.3f, hyperperiod %.0e, 20 hyperperiods)\n",
+		analysis.utilization, analysis.liu_layland, hyperperiod(tasks));
+	std::printf("%8s %10s %12s %10s %12s %14s %10s\n", "policy", "skip", "jobs", "misses", "max lateness", "skipped", "seconds");
+
+	EdfScheduler edf;
+	RmsScheduler rms;
+	for (Scheduler* scheduler : { static_cast<Scheduler*>(&edf), static_cast<Scheduler*>(&rms) }) {
+		for (bool skip : { false, true }) {
+			RealTimeConfig config;
+			config.horizon = 20 * hyperperiod(tasks);
+			config.skip_repeats = skip;
+			auto begin = std::chrono::steady_clock::now();
+			RealTimeResult result = run_realtime(tasks, *scheduler, config);
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+			std::printf("%8s %10s %12zu %10zu %12.0f %14zu %10.3f\n", scheduler->name(), skip ? "yes" : "no",
+				result.stats.deadline_jobs, result.stats.deadline_misses, result.stats.max_lateness,
+				result.skipped_windows, seconds);
+		}
+	}
+
+	// лأѹڱ߽״̬ԶظƼ鲻Ӧģ
+	std::vector<PeriodicTask> overloaded;
+	const double_t short_periods[] = { 4, 5, 10, 20 };
+	const double_t short_wcets[] = { 1, 1.5, 2.4, 3 };
+	for (int i = 0; i < 4; ++i) {
+		PeriodicTask task;
+		task.pid = i + 1;
+		task.period = short_periods[i];
+		task.wcet = short_wcets[i];
+		overloaded.push_back(task);
+	}
+	std::printf("\nReal-time RMS overloaded by switch cost (4 tasks, U = %.2f, hyperperiod %.0f, switch cost 0.1)\n",
+		analyze(overloaded).utilization, hyperperiod(overloaded));
+	std::printf("%8s %10s %12s %10s %12s %14s %10s\n", "horizon", "skip", "jobs", "pending", "simulated", "skipped", "seconds");
+	for (double_t horizon : { 1e5, 4e5 }) {
+		for (bool skip : { false, true }) {
+			RealTimeConfig config;
+			config.horizon = horizon;
+			config.skip_repeats = skip;
+			config.sim.context_switch = 0.1;
+			auto begin = std::chrono::steady_clock::now();
+			RealTimeResult result = run_realtime(overloaded, rms, config);
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+			std::printf("%8.0e %10s %12zu %10zu %12zu %14zu %10.3f\n", horizon, skip ? "yes" : "no",
+				result.stats.deadline_jobs, result.pending, result.simulated_windows, result.skipped_windows, seconds);
+		}
+	}
+}
+
+// ͼϸڲβüʷ 1920 ؿʱÿ֡ҪѯͼԪ޹
+static void bench_timeline() {
+	std::vector<PCB> process_list = random_workload(1000000, 1, 3);
+	RrConfig rr;
+	rr.quantum = 0.5;
+	RoundRobinScheduler scheduler(rr);
+	Timeline timeline;
+	Simulator sim(process_list, scheduler);
+	sim.set_timeline(&timeline);
+	auto begin = std::chrono::steady_clock::now();
+	sim.run();
+	double record_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	std::printf("\nTimeline LOD (%zu events -> %zu merged runs, recorded in %.2f s), 1920 columns\n",
+		sim.stats().events, timeline.size(), record_seconds);
+	std::printf("%24s %12s %12s\n", "view", "primitives", "ms/frame");
+
+	auto frame = [&](const char* name, double t0, double t1, int32_t first_lane, int32_t rows) {
+		const int frames = 50;
+		size_t primitives = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int f = 0; f < frames; ++f) {
+			primitives = 0;
+			for (int32_t lane = first_lane; lane < first_lane + rows; ++lane) {
+				primitives += timeline.for_each_visible(lane, t0, t1, 1920, [](double, double) {});
+			}
+		}
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+		std::printf("%24s %12zu %12.3f\n", name, primitives, ms);
+	};
+	double end = timeline.end_time();
+	frame("cpu row, full range", 0, end, -1, 1);
+	frame("cpu row, 1% zoom", end / 2, end / 2 + end / 100, -1, 1);
+	frame("300 process rows, full", 0, end, 0, 300);
+	frame("300 rows, 0.1% zoom", 0, end / 1000, 0, 300);
+}
+
+static void bench_histogram() {
+	// βĶ̬Ǻü
+	const size_t n = 10000000;
+	std::mt19937_64 gen(7);
+	std::lognormal_distribution<double> dist(3, 1.5);
+	std::vector<double> values(n);
+	for (auto& v : values) v = dist(gen);
+
+	LatencyHistogram histogram;
+	size_t i = 0;
+	double record_ns = ns_per_tick(n, [&] { histogram.record(values[i++]); });
+
+	LatencyHistogram other;
+	for (size_t k = 0; k < 1000; ++k) other.record(values[k]);
+	auto begin = std::chrono::steady_clock::now();
+	for (int k = 0; k < 100; ++k) histogram.merge(other);
+	double merge_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / 100;
+
+	std::printf("\nLatencyHistogram (%zu buckets): record %.2f ns, merge %.1f us\n", histogram.buckets(), record_ns, merge_us);
+
+	// õľȷλȽ
+	LatencyHistogram exact_input;
+	for (double v : values) exact_input.record(v);
+	std::sort(values.begin(), values.end());
+	std::printf("%10s %14s %14s %10s\n", "percentile", "exact", "histogram", "error");
+	for (size_t k = 0; k < LATENCY_PERCENTILE_COUNT; ++k) {
+		double p = LATENCY_PERCENTILES[k];
+		size_t rank = static_cast<size_t>(std::ceil(p / 100 * n));
+		double exact = values[std::max<size_t>(rank, 1) - 1];
+		double approx = exact_input.percentile(p);
+		std::printf("%10s %14.3f %14.3f %9.3f%%\n", LATENCY_PERCENTILE_NAMES[k], exact, approx, 100 * (approx - exact) / exact);
+	}
+}
+
+static void bench_process_table() {
+	const size_t n = 1000000;
+	const int repeat = 50;
+	std::printf("\nProcessTable (SoA) vs std::vector<PCB> (AoS), %zu processes, ns per pass\n", n);
+	std::printf("%18s %12s %12s %10s\n", "operation", "AoS", "SoA", "speedup");
+
+	std::vector<PCB> process_list = make_processes(n);
+	for (size_t i = 0; i < n; i += 3) process_list[i].state = State::E; // ֮һѽ
+	ProcessTable table(process_list);
+
+	volatile double_t sink = 0;
+	auto row = [&](const char* name, auto&& aos, auto&& soa) {
+		double aos_ns = ns_per_tick(repeat, aos);
+		double soa_ns = ns_per_tick(repeat, soa);
+		std::printf("%18s %12.0f %12.0f %9.1fx\n", name, aos_ns, soa_ns, aos_ns / soa_ns);
+	};
+
+	row("age", [&] {
+		for (auto& process : process_list) {
+			if (process.state == State::R) process.priority += 1;
+		}
+		}, [&] { table.age(1); });
+
+	row("count ready", [&] {
+		size_t count = 0;
+		for (const auto& process : process_list) count += process.state == State::R;
+		sink = sink + count;
+		}, [&] { sink = sink + table.count_ready(); });
+
+	row("total remaining", [&] {
+		double_t sum = 0;
+		for (const auto& process : process_list) {
+			if (process.state == State::R) sum += process.all_time;
+		}
+		sink = sink + sum;
+		}, [&] { sink = sink + table.total_remaining(); });
+
+	row("highest ready", [&] {
+		int64_t best = -1;
+		for (size_t i = 0; i < process_list.size(); ++i) {
+			if (process_list[i].state == State::R && (best < 0 || process_list[i].priority > process_list[best].priority)) best = i;
+		}
+		sink = sink + best;
+		}, [&] { sink = sink + table.highest_ready(); });
+}
+
+static void bench_sweep() {
+	SweepGrid grid;
+	grid.policies = { "priority", "mlfq", "cfs" };
+	grid.seeds = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	grid.process_counts = { 20000 };
+
+	size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+	std::printf("\nrun_sweep: %zu simulations\n", grid.policies.size() * grid.seeds.size());
+	std::printf("%8s %10s %10s\n", "threads", "seconds", "speedup");
+
+	double base = 0;
+	for (size_t threads : { size_t(1), hardware }) {
+		auto begin = std::chrono::steady_clock::now();
+		run_sweep(grid, threads);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		if (base == 0) base = seconds;
+		std::printf("%8zu %10.2f %9.1fx\n", threads, seconds, base / seconds);
+	}
+}
+
+static void bench_snapshot() {
+	std::printf("\nsnapshot fork: 1M processes, warm-up to t=1.5M, then 8 RR quanta (single thread)\n");
+	std::printf("%12s %10s %12s %12s %12s\n", "warm-up s", "MB", "save ms", "mapped ms", "sweep speedup");
+
+	std::vector<PCB> workload;
+	make_workload(workload, 1000000, 5, 3);
+	const double_t warmup = 1500000;
+	const double_t quanta[] = { 1, 2, 3, 4, 6, 8, 12, 16 };
+	using clock = std::chrono::steady_clock;
+	auto ms_since = [](clock::time_point begin) { return std::chrono::duration<double>(clock::now() - begin).count() * 1e3; };
+
+	std::vector<PCB> process_list = workload;
+	RoundRobinScheduler scheduler(RrConfig{ quanta[0] });
+	auto begin = clock::now();
+	BasicSimulator<RoundRobinScheduler> sim(process_list, scheduler);
+	sim.run_before(warmup);
+	double warmup_ms = ms_since(begin);
+
+	begin = clock::now();
+	SnapshotWriter out(SNAPSHOT_SCHEDULER);
+	sim.save(out);
+	out.save("bench.snap");
+	double save_ms = ms_since(begin);
+
+	// ӳļָ֮ÿʱƬͬһ״ֲ̬棬Դ 0 ʼԤȱȽ
+	double load_ms = 0, fork_ms = 0, full_ms = 0;
+	MappedSnapshot file;
+	file.open("bench.snap");
+	for (double_t quantum : quanta) {
+		std::vector<PCB> slots;
+		RoundRobinScheduler forked(RrConfig{ quantum });
+		begin = clock::now();
+		BasicSimulator<RoundRobinScheduler> variant(slots, forked);
+		SnapshotReader in(file.data(), file.size(), SNAPSHOT_SCHEDULER);
+		variant.load(in);
+		load_ms += ms_since(begin);
+		variant.run();
+		fork_ms += ms_since(begin);
+
+		std::vector<PCB> fresh = workload;
+		RoundRobinScheduler cold(RrConfig{ quantum });
+		begin = clock::now();
+		BasicSimulator<RoundRobinScheduler> baseline(fresh, cold);
+		baseline.run();
+		full_ms += ms_since(begin);
+	}
+	file.close();
+	std::remove("bench.snap");
+
+	std::printf("%12.2f %10.1f %12.1f %12.1f %12.2fx\n", warmup_ms / 1e3, out.data().size() / 1048576.0, save_ms,
+		load_ms / 8, full_ms / (warmup_ms + save_ms + fork_ms));
+}
+
+int main() {
+	bench_ready_queue();
+	bench_event_engine();
+	bench_static_dispatch();
+	bench_recording();
+	bench_io_mix();
+	bench_generator();
+	bench_multicore();
+	bench_affinity();
+	bench_cfs();
+	bench_sjf();
+	bench_round_robin();
+	bench_proportional_share();
+	bench_realtime();
+	bench_timeline();
+	bench_histogram();
+	bench_process_table();
+	bench_sweep();
+	bench_snapshot();
+	return 0;
+}
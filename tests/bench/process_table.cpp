@@ -0,0 +1,135 @@
+#include "process_table.h"
+
+#include <limits>
+
+#include "../test_1/bitops.h"
+
+ProcessTable::ProcessTable(const std::vector<PCB>& process_list) {
+	reserve(process_list.size());
+	for (const auto& process : process_list) push_back(process);
+}
+
+void ProcessTable::reserve(size_t n) {
+	pid.reserve(n);
+	priority.reserve(n);
+	remaining.reserve(n);
+	cpu_time.reserve(n);
+	ready_bits.reserve((n + 63) / 64);
+	blocked_bits.reserve((n + 63) / 64);
+}
+
+void ProcessTable::push_back(const PCB& process) {
+	size_t i = size();
+	pid.push_back(process.pid);
+	priority.push_back(process.priority);
+	remaining.push_back(process.all_time);
+	cpu_time.push_back(process.cpu_time);
+	if ((i & 63) == 0) {
+		ready_bits.push_back(0);
+		blocked_bits.push_back(0);
+	}
+	if (process.state == State::R && process.all_time > 0) ready_bits.back() |= uint64_t(1) << (i & 63);
+	if (process.state == State::B) blocked_bits.back() |= uint64_t(1) << (i & 63);
+}
+
+PCB ProcessTable::to_pcb(size_t i) const {
+	State state = ready(i) ? State::R : blocked(i) ? State::B : State::E;
+	return PCB(pid[i], priority[i], remaining[i], cpu_time[i], state);
+}
+
+void ProcessTable::run(size_t i, double_t time) {
+	if (!ready(i)) return;
+
+	if (time > remaining[i] - 1e-9) time = remaining[i];
+	remaining[i] -= time;
+	cpu_time[i] += time;
+	if (remaining[i] == 0) ready_bits[i >> 6] &= ~(uint64_t(1) << (i & 63));
+}
+
+// λͼ 64 һչ 0/1 룬ڲѭûз֧
+void ProcessTable::age(int32_t delta) {
+	int32_t* p = priority.data();
+	size_t n = size();
+	for (size_t block = 0; block * 64 < n; ++block) {
+		uint64_t bits = ready_bits[block];
+		if (bits == 0) continue;
+
+		size_t base = block * 64;
+		size_t count = n - base < 64 ? n - base : 64;
+		for (size_t j = 0; j < count; ++j) {
+			p[base + j] += delta * static_cast<int32_t>((bits >> j) & 1);
+		}
+	}
+}
+
+size_t ProcessTable::count_ready() const {
+	size_t count = 0;
+	for (uint64_t bits : ready_bits) count += popcount(bits);
+	return count;
+}
+
+double_t ProcessTable::total_remaining() const {
+	// push_back ѽ̵ʣʱ䣬λͼͣ age һ 64 һչڲѭûз֧
+	const double_t* r = remaining.data();
+	size_t n = size();
+	double_t sum[4] = { 0, 0, 0, 0 };
+	for (size_t block = 0; block * 64 < n; ++block) {
+		uint64_t bits = ready_bits[block];
+		if (bits == 0) continue;
+
+		size_t base = block * 64;
+		size_t count = n - base < 64 ? n - base : 64;
+		for (size_t j = 0; j < count; ++j) {
+			sum[j & 3] += r[base + j] * static_cast<double_t>((bits >> j) & 1);
+		}
+	}
+	return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+double_t ProcessTable::total_cpu_time() const {
+	const double_t* c = cpu_time.data();
+	size_t n = size();
+	double_t sum[4] = { 0, 0, 0, 0 };
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		sum[0] += c[i];
+		sum[1] += c[i + 1];
+		sum[2] += c[i + 2];
+		sum[3] += c[i + 3];
+	}
+	for (; i < n; ++i) sum[0] += c[i];
+	return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+int64_t ProcessTable::highest_ready() const {
+	const int32_t* p = priority.data();
+	size_t n = size();
+	int64_t best = -1;
+	int32_t best_priority = 0; //best >= 0 ʱЧ INT32_MIN δҵ
+
+	for (size_t block = 0; block * 64 < n; ++block) {
+		uint64_t bits = ready_bits[block];
+		if (bits == 0) continue;
+
+		// ޷ֵ֧ҵһֵľ
+		size_t base = block * 64;
+		size_t count = n - base < 64 ? n - base : 64;
+		const int32_t lowest = std::numeric_limits<int32_t>::min();
+		int32_t block_max = lowest;
+		for (size_t j = 0; j < count; ++j) {
+			int32_t mask = -static_cast<int32_t>((bits >> j) & 1);
+			int32_t masked = (p[base + j] & mask) | (lowest & ~mask);
+			block_max = masked > block_max ? masked : block_max;
+		}
+		if (best >= 0 && block_max <= best_priority) continue;
+
+		while (bits) {
+			int32_t j = find_first_set(bits);
+			if (p[base + j] == block_max) break;
+			bits &= bits - 1;
+		}
+		best_priority = block_max;
+		best = static_cast<int64_t>(base + find_first_set(bits));
+	}
+	return best;
+}
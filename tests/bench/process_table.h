@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../test_1/pcb.h"
+
+// ṹ飨SoAʽḺ̌ÿһеţɨʱֻҪֶΣ
+// ѭдɱԶʽ״̬λͼ棬 i λΪ 1 ʾ i 
+// һλͼŶΪ 0 ѽֻ̡ bench  SoA  AoS ĶԱȣģʹá
+class ProcessTable {
+public:
+	ProcessTable() {}
+	explicit ProcessTable(const std::vector<PCB>& process_list);
+
+	size_t size() const { return pid.size(); }
+	void reserve(size_t n);
+	void push_back(const PCB& process);
+	PCB to_pcb(size_t i) const;
+
+	bool ready(size_t i) const { return (ready_bits[i >> 6] >> (i & 63)) & 1; }
+	bool blocked(size_t i) const { return (blocked_bits[i >> 6] >> (i & 63)) & 1; }
+	void run(size_t i, double_t time); // timeĽλ
+
+	void age(int32_t delta);           //оȼ delta
+	size_t count_ready() const;
+	double_t total_remaining() const;  //ʣʱ֮
+	double_t total_cpu_time() const;
+	int64_t highest_ready() const;     //ȼߵľ±꣨ͬȼȡ±Сģûʱ -1
+
+	std::vector<int32_t> pid;
+	std::vector<int32_t> priority;
+	std::vector<double_t> remaining;
+	std::vector<double_t> cpu_time;
+	std::vector<uint64_t> ready_bits;
+	std::vector<uint64_t> blocked_bits;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+//  --key value ʽв --flag Ϊ "1"
+class CommandLine {
+public:
+	CommandLine(int argc, char** argv) {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			if (arg.compare(0, 2, "--") != 0) {
+				positional = arg;
+				continue;
+			}
+			std::string key = arg.substr(2);
+			if (i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0) options[key] = argv[++i];
+			else options[key] = "1";
+		}
+	}
+
+	bool has(const std::string& key) const { return options.count(key) > 0; }
+
+	std::string get(const std::string& key, const std::string& fallback = "") const {
+		auto it = options.find(key);
+		return it == options.end() ? fallback : it->second;
+	}
+
+	double get_number(const std::string& key, double fallback) const {
+		auto it = options.find(key);
+		return it == options.end() ? fallback : std::atof(it->second.c_str());
+	}
+
+	// ŷָб "priority,mlfq"
+	std::vector<std::string> get_list(const std::string& key, const std::string& fallback) const {
+		std::vector<std::string> items;
+		std::string value = get(key, fallback);
+		size_t begin = 0;
+		while (begin <= value.size()) {
+			size_t end = value.find(',', begin);
+			if (end == std::string::npos) end = value.size();
+			if (end > begin) items.push_back(value.substr(begin, end - begin));
+			begin = end + 1;
+		}
+		return items;
+	}
+
+	// бд "a-b" "1-10,20"
+	std::vector<double> get_numbers(const std::string& key, const std::string& fallback) const {
+		std::vector<double> numbers;
+		for (const auto& item : get_list(key, fallback)) {
+			size_t dash = item.find('-', 1);
+			if (dash == std::string::npos) {
+				numbers.push_back(std::atof(item.c_str()));
+				continue;
+			}
+			long first = std::atol(item.substr(0, dash).c_str());
+			long last = std::atol(item.substr(dash + 1).c_str());
+			for (long i = first; i <= last; ++i) numbers.push_back(static_cast<double>(i));
+		}
+		return numbers;
+	}
+
+	std::string positional; //һ -- Ĳ
+
+private:
+	std::map<std::string, std::string> options;
+};
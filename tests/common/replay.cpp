@@ -0,0 +1,140 @@
+#include "replay.h"
+
+#include <algorithm>
+
+bool KeyframeStore::check(uint64_t index, uint64_t bytes) {
+	expected = bytes;
+	if (frames.empty()) return true;
+	double estimate = bytes > 0 && cost_per_byte > 0 ? bytes * cost_per_byte : last_cost;
+	Clock::time_point now = Clock::now();
+	if (std::chrono::duration<double>(now - last_end).count() * budget >= estimate &&
+		spent + estimate <= std::chrono::duration<double>(now - origin).count() * budget) return true;
+	next_check = index + CHECK_EVERY;
+	return false;
+}
+
+bool KeyframeStore::want_full() const {
+	if (frames.empty()) return true;
+	const Keyframe* base = base_of(frames.back());
+	uint64_t chain = 0;
+	for (const Keyframe* k = base + 1; k <= &frames.back(); ++k) chain += k->bytes;
+	return chain >= base->bytes;
+}
+
+SnapshotWriter& KeyframeStore::begin(uint64_t index, double time, bool full) {
+	started = Clock::now();
+	if (frames.empty()) {
+		origin = started;
+		spent = 0;
+	}
+
+	// ¹ؼ֡ĴСͬһ
+	uint64_t estimate = 0;
+	for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+		if (it->full == full) {
+			estimate = it->bytes;
+			break;
+		}
+	}
+	make_room(estimate);
+	if (spare.empty()) {
+		frames.emplace_back(kind);
+	}
+	else {
+		frames.push_back(std::move(spare.back()));
+		spare.pop_back();
+	}
+
+	Keyframe& frame = frames.back();
+	frame.index = index;
+	frame.time = time;
+	frame.bytes = 0;
+	frame.full = full;
+	frame.data.clear();
+	frame.data.reserve(static_cast<size_t>(estimate + estimate / 4));
+	return frame.data;
+}
+
+void KeyframeStore::end() {
+	Keyframe& frame = frames.back();
+	frame.bytes = frame.data.data().size();
+	resident_bytes += frame.bytes;
+	last_end = Clock::now();
+	double cost = std::chrono::duration<double>(last_end - started).count();
+	spent += cost;
+	// ֮֡´׵ؼ֡Ƴһ֡ĿۼԤе
+	if (!frame.full || frames.size() < 2 || frames[frames.size() - 2].full) {
+		last_cost = cost;
+		// ·ڴ״дȸõÿֽڵĺʱƫĹƣֻµ
+		cost_per_byte = expected > 0 ? std::max(cost / expected, cost_per_byte / 2) : 0;
+	}
+	expected = 0;
+	next_check = frame.index + CHECK_EVERY;
+}
+
+void KeyframeStore::make_room(uint64_t incoming) {
+	while (!frames.empty() && resident_bytes + incoming > memory_limit) {
+		if (!thin()) return;
+	}
+}
+
+// 鱣һ飨ʷ㣩µһ飬һ鶪һ飻ֻ֡ؼ֡һ
+bool KeyframeStore::thin() {
+	const Keyframe* last_base = base_of(frames.back());
+	size_t group = 0, kept = 0;
+	bool dropped = false;
+	for (size_t i = 0; i < frames.size(); ++i) {
+		if (i > 0 && frames[i].full) group++;
+		if (group % 2 == 0 || &frames[i] >= last_base) {
+			if (kept != i) frames[kept] = std::move(frames[i]);
+			kept++;
+		}
+		else {
+			release(frames[i]);
+			dropped = true;
+		}
+	}
+	frames.resize(kept, Keyframe(kind));
+	return dropped;
+}
+
+void KeyframeStore::release(Keyframe& frame) {
+	resident_bytes -= frame.bytes;
+	frame.bytes = 0;
+	spare.push_back(std::move(frame));
+}
+
+const Keyframe* KeyframeStore::at_or_before(uint64_t index) const {
+	auto it = std::upper_bound(frames.begin(), frames.end(), index,
+		[](uint64_t i, const Keyframe& frame) { return i < frame.index; });
+	return it == frames.begin() ? nullptr : &*(it - 1);
+}
+
+const Keyframe* KeyframeStore::base_of(const Keyframe& frame) const {
+	const Keyframe* base = &frame;
+	while (!base->full && base > frames.data()) --base;
+	return base;
+}
+
+void KeyframeStore::truncate(uint64_t index) {
+	while (!frames.empty() && frames.back().index > index) {
+		release(frames.back());
+		frames.pop_back();
+	}
+}
+
+void KeyframeStore::clear() {
+	truncate(0);
+	if (!frames.empty()) {
+		release(frames.back());
+		frames.pop_back();
+	}
+	// һ¼ƾͰѻϵͳڴ͸ڴдٶȲ
+	// ͬһ¼֡ڴϣһ֡Ĵ۲ſɿ
+	spare.clear();
+	next_check = 0;
+	last_cost = 0;
+	cost_per_byte = 0;
+	expected = 0;
+	spent = 0;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "snapshot.h"
+
+// ¼¼ĻλΪ 2 ݣʱһηãpush ڴ档д󸲸ɵļ¼
+template <typename Record>
+class EventRing {
+	static_assert(std::is_trivially_copyable<Record>::value, "event records must be trivially copyable");
+
+public:
+	explicit EventRing(size_t capacity = size_t(1) << 16) {
+		size_t n = 2;
+		while (n < capacity) n <<= 1;
+		slots.resize(n);
+		mask = n - 1;
+	}
+
+	void push(const Record& record) {
+		slots[total & mask] = record;
+		total++;
+	}
+
+	uint64_t size() const { return total; }  //ۼдļ¼һ¼
+	uint64_t first() const { return total > slots.size() ? total - slots.size() : 0; } //ڴ
+	size_t capacity() const { return slots.size(); }
+	const Record& at(uint64_t index) const { return slots[index & mask]; } //first() <= index < size()
+
+	//  >= index ļ¼֧ɵġδϣ
+	void truncate(uint64_t index) {
+		if (index < total) total = index < first() ? first() : index;
+	}
+
+	void clear() { total = 0; }
+
+private:
+	std::vector<Record> slots;
+	size_t mask = 0;
+	uint64_t total = 0;
+};
+
+// ؼ֡ index ¼֮Ŀաfull Ϊ false ʱֻ֡һؼ֮֡ĹĲ֣
+// Ӵǰؼ֡룬ε֡
+struct Keyframe {
+	uint64_t index = 0;
+	double time = 0;
+	SnapshotWriter data;
+	uint64_t bytes = 0;  //յֽ
+	bool full = true;
+
+	explicit Keyframe(uint32_t kind) : data(kind) {}
+};
+
+// Թؼ֡Ƿôؼ֡ʱһؼ֡ǽʱԤƱʱ 1 / budget 
+// Ҵӵһؼ֡ۼƵıʱһΣԤԲʱ budget
+// ԱյĿģʱ budgetʱÿ CHECK_EVERY ¼ŶһΡ
+// ֡ۼƵֽﵽؼ֡ʱwant_fullĴؼ֡ĿֻۼƣƳһؼ֡
+// ؿλؼ֡Сݣطһؼ֡Լ 1 / budget ĵձʱ䣩
+//  memory_limit ʱ飨ؼ֡֡Ϊλһ飨ʷ㣩µһ飬
+// һ鶪һ飬ʼոǴͷʼȫʷĻ֮Ĺؼ֡á
+class KeyframeStore {
+public:
+	static constexpr uint64_t CHECK_EVERY = 1024;
+	static constexpr uint64_t DEFAULT_MEMORY_LIMIT = uint64_t(256) << 20;
+
+	explicit KeyframeStore(uint32_t kind, uint64_t memory_limit = DEFAULT_MEMORY_LIMIT, double budget = 0.03) :
+		kind(kind), memory_limit(memory_limit), budget(budget) {}
+
+	// bytes Ϊ÷Ƶһؼֽ֡ʱһؼ֡ÿֽڵĺʱԤεĿ
+	// ֡ҲᳬԤ㣻Ϊ 0 ʱһؼ֡ĺʱ
+	bool due(uint64_t index, uint64_t bytes = 0) { return index >= next_check && check(index, bytes); }
+
+	SnapshotWriter& begin(uint64_t index, double time, bool full = true);
+	void end();
+	bool want_full() const; //һؼ֡Ӧģûйؼ֡һ֡ۼѲСؼ֡
+
+	// Ų index һؼ֡ûʱ nullptr
+	const Keyframe* at_or_before(uint64_t index) const;
+	const Keyframe* base_of(const Keyframe& frame) const; //frame ؼ֡
+	const Keyframe* oldest() const { return frames.empty() ? nullptr : &frames.front(); }
+	const Keyframe* newest() const { return frames.empty() ? nullptr : &frames.back(); }
+	size_t size() const { return frames.size(); }
+
+	SnapshotReader open(const Keyframe& frame) const { return SnapshotReader(frame.data.data(), kind); }
+
+	uint64_t memory_bytes() const { return resident_bytes; }
+	double spent_seconds() const { return spent; } //ӵһؼ֡𱣴ؼ֡
+
+	void truncate(uint64_t index); // > index Ĺؼ֡
+	void clear();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	bool check(uint64_t index, uint64_t bytes);
+	void make_room(uint64_t incoming);
+	bool thin();
+	void release(Keyframe& frame); //Ž spareֻͬһ¼︴
+
+	uint32_t kind;
+	uint64_t memory_limit;
+	double budget;
+	std::vector<Keyframe> frames;
+	std::vector<Keyframe> spare;
+	uint64_t next_check = 0;
+	Clock::time_point started;     //ڱĹؼ֡ʼʱ
+	Clock::time_point last_end;    //һؼ֡ʱ
+	double last_cost = 0;          //һıһ֡ģû֡ʱһؼ֡
+	double cost_per_byte = 0;      //ȹƵֽÿֽڱûйʱΪ 0
+	uint64_t expected = 0;         //ιؼ֡ȹƵֽ
+	Clock::time_point origin;      //һؼ֡ʼʱ
+	double spent = 0;              // origin 𱣴ؼ֡
+	uint64_t resident_bytes = 0;
+};
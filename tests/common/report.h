@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ޽ʱָһ (, ֵ)д CSV  JSON 
+class Report {
+public:
+	enum Format { CSV, JSON };
+
+	void begin_row() { rows.emplace_back(); }
+	bool empty() const { return rows.empty(); }
+
+	void add(const std::string& key, double value) { rows.back().push_back({ key, number(value), false }); }
+	void add(const std::string& key, int64_t value) { rows.back().push_back({ key, std::to_string(value), false }); }
+	void add(const std::string& key, size_t value) { rows.back().push_back({ key, std::to_string(value), false }); }
+	void add(const std::string& key, int32_t value) { rows.back().push_back({ key, std::to_string(value), false }); }
+	void add(const std::string& key, const std::string& value) { rows.back().push_back({ key, value, true }); }
+	void add(const std::string& key, const char* value) { add(key, std::string(value)); }
+
+	void write(std::ostream& out, Format format) const {
+		if (format == CSV) write_csv(out);
+		else write_json(out);
+	}
+
+	// path Ϊʱд׼
+	bool save(const std::string& path, Format format) const {
+		if (path.empty()) {
+			write(std::cout, format);
+			return true;
+		}
+
+		std::ofstream out(path);
+		if (!out) {
+			std::cerr << "Failed to create output: " << path << std::endl;
+			return false;
+		}
+		write(out, format);
+		return true;
+	}
+
+	static bool parse_format(const std::string& name, Format& format) {
+		if (name == "csv") format = CSV;
+		else if (name == "json") format = JSON;
+		else return false;
+		return true;
+	}
+
+private:
+	struct Field {
+		std::string key;
+		std::string value;
+		bool is_string;
+	};
+
+	static std::string number(double value) {
+		if (!std::isfinite(value)) return "null";
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+		return buffer;
+	}
+
+	void write_csv(std::ostream& out) const {
+		if (rows.empty()) return;
+		for (size_t i = 0; i < rows[0].size(); ++i) out << (i ? "," : "") << rows[0][i].key;
+		out << "\n";
+		for (const auto& row : rows) {
+			for (size_t i = 0; i < row.size(); ++i) {
+				out << (i ? "," : "");
+				if (row[i].is_string && row[i].value.find_first_of(",\"\n") != std::string::npos) out << csv_escape(row[i].value);
+				else out << row[i].value;
+			}
+			out << "\n";
+		}
+	}
+
+	static std::string csv_escape(const std::string& value) {
+		std::string result = "\"";
+		for (char c : value) {
+			if (c == '"') result += '"';
+			result += c;
+		}
+		return result + "\"";
+	}
+
+	void write_json(std::ostream& out) const {
+		out << "[\n";
+		for (size_t r = 0; r < rows.size(); ++r) {
+			out << "  {";
+			for (size_t i = 0; i < rows[r].size(); ++i) {
+				const Field& field = rows[r][i];
+				out << (i ? ", " : "") << json_escape(field.key) << ": ";
+				out << (field.is_string ? json_escape(field.value) : field.value);
+			}
+			out << (r + 1 < rows.size() ? "},\n" : "}\n");
+		}
+		out << "]\n";
+	}
+
+	static std::string json_escape(const std::string& value) {
+		std::string result = "\"";
+		for (char c : value) {
+			if (c == '"' || c == '\\') result += '\\';
+			result += c;
+		}
+		return result + "\"";
+	}
+
+	std::vector<std::vector<Field>> rows;
+};
@@ -0,0 +1,90 @@
+#include "snapshot.h"
+
+#include <cstdio>
+#include <iostream>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool SnapshotWriter::save(const std::string& path) const {
+	const std::vector<char>& bytes = data();
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+	if (!file) {
+		std::cerr << "Failed to create snapshot: " << path << std::endl;
+		return false;
+	}
+	bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+	ok = std::fclose(file) == 0 && ok;
+	if (!ok) std::cerr << "Failed to write snapshot: " << path << std::endl;
+	return ok;
+}
+
+SnapshotReader::SnapshotReader(const char* data, size_t size, uint32_t kind) {
+	SnapshotHeader header;
+	if (!data || size < sizeof(header)) return;
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, SnapshotHeader().magic, sizeof(header.magic)) != 0 || header.version != 1 ||
+		header.kind != kind || header.size > size - sizeof(header)) return;
+
+	begin = data;
+	cursor = data + sizeof(header);
+	end = cursor + header.size;
+	good = true;
+}
+
+bool MappedSnapshot::open(const std::string& path) {
+	close();
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		std::cerr << "Failed to open snapshot: " << path << std::endl;
+		return false;
+	}
+	LARGE_INTEGER size;
+	GetFileSizeEx(file, &size);
+	view_size = static_cast<uint64_t>(size.QuadPart);
+	file_handle = file;
+	mapping_handle = view_size > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	view = mapping_handle ? static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		std::cerr << "Failed to open snapshot: " << path << std::endl;
+		return false;
+	}
+	struct stat st;
+	fstat(fd, &st);
+	view_size = static_cast<uint64_t>(st.st_size);
+	void* p = view_size > 0 ? mmap(nullptr, view_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+	::close(fd); //ӳ佨Ҫļ
+	view = p == MAP_FAILED ? nullptr : static_cast<const char*>(p);
+#endif
+
+	if (!view) {
+		std::cerr << "Failed to map snapshot: " << path << std::endl;
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedSnapshot::close() {
+#if defined(_WIN32)
+	if (view) UnmapViewOfFile(view);
+	if (mapping_handle) CloseHandle(mapping_handle);
+	if (file_handle) CloseHandle(file_handle);
+	mapping_handle = file_handle = nullptr;
+#else
+	if (view) munmap(const_cast<char*>(view), view_size);
+#endif
+	view = nullptr;
+	view_size = 0;
+}
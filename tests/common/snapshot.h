@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// ƿգļͷһд˳еֶΣֶΰڴ沼ԭдֻͬһĳ֮ͨá
+// дԪظдԭʼֽڲ뵽 8 ֽڣʱӳļ鸴ƽ vector
+// kind ֿյԴģ⡢λģĹؼ֡ڴ䣩ʱдʱͬ
+struct SnapshotHeader {
+	char magic[8] = { 'O', 'S', 'S', 'N', 'A', 'P', '\0', '\0' };
+	uint32_t version = 1;
+	uint32_t kind = 0;
+	uint64_t size = 0;  //ļͷֽ
+};
+
+static_assert(sizeof(SnapshotHeader) == 24, "SnapshotHeader layout");
+
+enum SnapshotKind : uint32_t {
+	SNAPSHOT_SCHEDULER = 1,
+	SNAPSHOT_MEMORY = 2,
+	SNAPSHOT_TICKS = 3
+};
+
+class SnapshotWriter {
+public:
+	explicit SnapshotWriter(uint32_t kind) {
+		SnapshotHeader header;
+		header.kind = kind;
+		buffer.assign(reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header) + sizeof(header));
+	}
+
+	template <typename T>
+	void put(const T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+		append(&value, sizeof(value));
+	}
+
+	template <typename T>
+	void put_array(const T* values, size_t count) {
+		static_assert(std::is_trivially_copyable<T>::value, "snapshot arrays must be trivially copyable");
+		put(static_cast<uint64_t>(count));
+		append(values, count * sizeof(T));
+		pad();
+	}
+
+	template <typename T>
+	void put_array(const std::vector<T>& values) { put_array(values.data(), values.size()); }
+
+	// ֻд values ± ids Ԫأ ids ˳򣻶ʱ put_array дͬ
+	template <typename T, typename Index>
+	void put_selected(const std::vector<T>& values, const std::vector<Index>& ids) {
+		static_assert(std::is_trivially_copyable<T>::value, "snapshot arrays must be trivially copyable");
+		put(static_cast<uint64_t>(ids.size()));
+		for (Index id : ids) append(&values[static_cast<size_t>(id)], sizeof(T));
+		pad();
+	}
+
+	void put_string(const std::string& value) { put_array(value.data(), value.size()); }
+
+	// ׼水׼涨ıʽ棬ͬһڸƽ̨϶ص״̬ͬ
+	template <typename Engine>
+	void put_engine(const Engine& engine) {
+		std::ostringstream text;
+		text << engine;
+		put_string(text.str());
+	}
+
+	const std::vector<char>& data() const { return buffer; }
+
+	bool save(const std::string& path) const;
+
+	// дֶΣļͷѷĿռ䣬ظдʱٷڴ
+	void clear() { resize(sizeof(SnapshotHeader)); }
+	// Ԥռ䣬дʱη
+	void reserve(size_t bytes) { buffer.reserve(bytes); }
+
+private:
+	// ֱ׷ӶȲٸǣֻдһ
+	void append(const void* data, size_t size) {
+		const char* bytes = static_cast<const char*>(data);
+		buffer.insert(buffer.end(), bytes, bytes + size);
+		update_size();
+	}
+
+	void pad() { resize((buffer.size() + 7) & ~size_t(7)); }
+
+	// ļͷĳдģdata() κʱĿ
+	void resize(size_t size) {
+		buffer.resize(size, 0);
+		update_size();
+	}
+
+	void update_size() {
+		uint64_t fields = buffer.size() - sizeof(SnapshotHeader);
+		std::memcpy(buffer.data() + offsetof(SnapshotHeader, size), &fields, sizeof(fields));
+	}
+
+	std::vector<char> buffer;
+};
+
+// д˳ֶΡԽʽжȡ falseһ ok() ɡ
+class SnapshotReader {
+public:
+	SnapshotReader(const char* data, size_t size, uint32_t kind);
+	SnapshotReader(const std::vector<char>& data, uint32_t kind) : SnapshotReader(data.data(), data.size(), kind) {}
+
+	bool ok() const { return good; }
+
+	template <typename T>
+	bool get(T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+		const char* p = take(sizeof(value));
+		if (p) std::memcpy(&value, p, sizeof(value));
+		return p != nullptr;
+	}
+
+	template <typename T>
+	bool get_array(std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable<T>::value, "snapshot arrays must be trivially copyable");
+		static_assert(alignof(T) <= 8, "snapshot arrays are 8-byte aligned");
+		uint64_t count = 0;
+		if (!get(count) || count > static_cast<uint64_t>(end - cursor) / sizeof(T)) return fail();
+		// 㰴 8 ֽڶ룬ֱӵ T 鸴
+		const T* first = reinterpret_cast<const T*>(take(static_cast<size_t>(count * sizeof(T))));
+		values.assign(first, first + count);
+		skip_pad();
+		return good;
+	}
+
+	bool get_string(std::string& value) {
+		uint64_t count = 0;
+		if (!get(count) || count > static_cast<uint64_t>(end - cursor)) return fail();
+		value.assign(take(static_cast<size_t>(count)), static_cast<size_t>(count));
+		skip_pad();
+		return good;
+	}
+
+	template <typename Engine>
+	bool get_engine(Engine& engine) {
+		std::string text;
+		if (!get_string(text)) return false;
+		std::istringstream in(text);
+		in >> engine;
+		return in ? good : fail();
+	}
+
+	bool fail() { good = false; return false; }
+
+private:
+	const char* take(size_t size) {
+		if (!good || static_cast<size_t>(end - cursor) < size) {
+			good = false;
+			return nullptr;
+		}
+		const char* p = cursor;
+		cursor += size;
+		return p;
+	}
+
+	void skip_pad() {
+		size_t used = cursor - begin;
+		take(((used + 7) & ~size_t(7)) - used);
+	}
+
+	const char* begin = nullptr;  //ļͷ밴
+	const char* cursor = nullptr;
+	const char* end = nullptr;
+	bool good = false;
+};
+
+// ֻӳļSnapshotReader ֱӳ϶ֻװ vector ʱһ
+class MappedSnapshot {
+public:
+	MappedSnapshot() {}
+	~MappedSnapshot() { close(); }
+
+	MappedSnapshot(const MappedSnapshot&) = delete;
+	MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+	bool open(const std::string& path);
+	void close();
+
+	const char* data() const { return view; }
+	size_t size() const { return static_cast<size_t>(view_size); }
+
+private:
+	const char* view = nullptr;
+	uint64_t view_size = 0;
+
+#if defined(_WIN32)
+	void* file_handle = nullptr;
+	void* mapping_handle = nullptr;
+#endif
+};
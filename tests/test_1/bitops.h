@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// bits Ϊ 0
+inline int32_t find_first_set(uint64_t bits) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return static_cast<int32_t>(index);
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+inline int32_t popcount(uint64_t bits) {
+#if defined(_MSC_VER)
+	return static_cast<int32_t>(__popcnt64(bits));
+#else
+	return __builtin_popcountll(bits);
+#endif
+}
+
+// λ±꣬bits Ϊ 0
+inline int32_t find_last_set(uint64_t bits) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, bits);
+	return static_cast<int32_t>(index);
+#else
+	return 63 - __builtin_clzll(bits);
+#endif
+}
@@ -0,0 +1,126 @@
+#include "cfs.h"
+
+#include <algorithm>
+
+//  Linux  sched_prio_to_weight ͬnice -20 ~ 19һԼ 1.25 
+static const int32_t prio_to_weight[40] = {
+	88761, 71755, 56483, 46273, 36291,
+	29154, 23254, 18705, 14949, 11916,
+	9548, 7620, 6100, 4904, 3906,
+	3121, 2501, 1991, 1586, 1277,
+	1024, 820, 655, 526, 423,
+	335, 272, 215, 172, 137,
+	110, 87, 70, 56, 45,
+	36, 29, 23, 18, 15,
+};
+
+int32_t CfsScheduler::nice_of(int32_t priority) {
+	return std::min(19, std::max(-20, -2 * (priority - 3)));
+}
+
+int32_t CfsScheduler::weight_of(int32_t nice) {
+	return prio_to_weight[nice + 20];
+}
+
+void CfsScheduler::reset(std::vector<PCB>& process_list) {
+	this->process_list = &process_list;
+	timeline.clear();
+	total_weight = 0;
+	min_vruntime = 0;
+
+	weight.resize(process_list.size());
+	for (size_t i = 0; i < process_list.size(); ++i) {
+		weight[i] = weight_of(nice_of(process_list[i].priority));
+	}
+}
+
+void CfsScheduler::enqueue(int32_t id) {
+	timeline.emplace((*process_list)[id].vruntime, id);
+}
+
+void CfsScheduler::on_arrival(int32_t id, double_t now) {
+	// ½̴ӵǰС vruntime ʼ֮ܿǰûл۵ġǷˡڰռ CPU
+	PCB& process = (*process_list)[id];
+	if (static_cast<size_t>(id) >= weight.size()) weight.resize(id + 1);
+	weight[id] = weight_of(nice_of(process.priority));
+	process.vruntime = std::max(process.vruntime, min_vruntime);
+	total_weight += weight[id];
+	enqueue(id);
+}
+
+int32_t CfsScheduler::pick_next(double_t now) {
+	if (timeline.empty()) return -1;
+
+	auto leftmost = timeline.begin();
+	int32_t id = leftmost->second;
+	timeline.erase(leftmost);
+	return id;
+}
+
+double_t CfsScheduler::time_slice(int32_t id, double_t now) {
+	if (timeline.empty()) return RUN_TO_END;
+
+	// Ȩطһڣ̺ܶʱ֤ÿʱƬС min_granularity
+	double_t period = std::max(config.sched_latency, config.min_granularity * (timeline.size() + 1));
+	return std::max(config.min_granularity, period * weight[id] / total_weight);
+}
+
+void CfsScheduler::on_run(int32_t id, double_t ran, double_t now) {
+	PCB& process = (*process_list)[id];
+	process.vruntime += ran * prio_to_weight[20] / weight[id];
+
+	double_t leftmost = timeline.empty() ? process.vruntime : std::min(process.vruntime, timeline.begin()->first);
+	min_vruntime = std::max(min_vruntime, leftmost);
+}
+
+void CfsScheduler::on_requeue(int32_t id, double_t now) {
+	enqueue(id);
+}
+
+void CfsScheduler::on_finish(int32_t id, double_t now) {
+	total_weight -= weight[id];
+}
+
+void CfsScheduler::on_block(int32_t id, double_t now) {
+	total_weight -= weight[id];
+}
+
+void CfsScheduler::on_wakeup(int32_t id, double_t now) {
+	// ˯ߵĽಹڣܽϿУ˯ʱµǷ˳ڰռ CPU
+	PCB& process = (*process_list)[id];
+	process.vruntime = std::max(process.vruntime, min_vruntime - config.sched_latency / 2);
+	total_weight += weight[id];
+	enqueue(id);
+}
+
+bool CfsScheduler::should_preempt(int32_t running, int32_t arrived, double_t now) {
+	const PCB& a = (*process_list)[arrived];
+	const PCB& r = (*process_list)[running];
+	return a.vruntime + config.wakeup_granularity * prio_to_weight[20] / weight[arrived] < r.vruntime;
+}
+
+// չ鱣棬ʱ˳룬ÿζĩβ̯ O(1)
+void CfsScheduler::save(SnapshotWriter& out) const {
+	std::vector<double_t> keys;
+	std::vector<int32_t> ids;
+	keys.reserve(timeline.size());
+	ids.reserve(timeline.size());
+	for (const auto& node : timeline) {
+		keys.push_back(node.first);
+		ids.push_back(node.second);
+	}
+	out.put_array(keys);
+	out.put_array(ids);
+	out.put_array(weight);
+	out.put(total_weight);
+	out.put(min_vruntime);
+}
+
+bool CfsScheduler::load(SnapshotReader& in) {
+	std::vector<double_t> keys;
+	std::vector<int32_t> ids;
+	if (!in.get_array(keys) || !in.get_array(ids) || keys.size() != ids.size()) return in.fail();
+	timeline.clear();
+	for (size_t i = 0; i < keys.size(); ++i) timeline.emplace_hint(timeline.end(), keys[i], ids[i]);
+	return in.get_array(weight) && in.get(total_weight) && in.get(min_vruntime);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+
+struct CfsConfig {
+	double_t sched_latency = 24;     //һо̶һεĿ
+	double_t min_granularity = 3;    //ʱƬ
+	double_t wakeup_granularity = 4; //µ̵ vruntime ҪСôռ
+};
+
+// ȫƽȣvruntime  nice ӦȨ vruntime СĽ̡
+// ǰ (vruntime, ±) ĺstd::setڵ㼴һ̣begin() Ϊ O(1)
+class CfsScheduler final : public Scheduler {
+public:
+	explicit CfsScheduler(const CfsConfig& config = CfsConfig()) : config(config) {}
+
+	const char* name() const override { return "CFS"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override;
+	int32_t pick_next(double_t now) override;
+	double_t time_slice(int32_t id, double_t now) override;
+	void on_run(int32_t id, double_t ran, double_t now) override;
+	void on_requeue(int32_t id, double_t now) override;
+	void on_finish(int32_t id, double_t now) override;
+	void on_block(int32_t id, double_t now) override;
+	void on_wakeup(int32_t id, double_t now) override;
+	bool should_preempt(int32_t running, int32_t arrived, double_t now) override;
+
+	void save(SnapshotWriter& out) const override;
+	bool load(SnapshotReader& in) override;
+
+	static int32_t nice_of(int32_t priority); //ȼ 1~5 ӳ䵽 niceȼԽ nice ԽС
+	static int32_t weight_of(int32_t nice);
+
+private:
+	void enqueue(int32_t id);
+
+	CfsConfig config;
+	std::vector<PCB>* process_list = nullptr;
+	std::set<std::pair<double_t, int32_t>> timeline;
+	std::vector<int32_t> weight;
+	int64_t total_weight = 0;   //н̵Ȩغ
+	double_t min_vruntime = 0;
+};
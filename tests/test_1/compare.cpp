@@ -0,0 +1,96 @@
+#include "compare.h"
+
+#include <algorithm>
+#include <iostream>
+
+SharedWorkload share_workload(std::vector<PCB> process_list) {
+	process_list.erase(std::remove_if(process_list.begin(), process_list.end(), [](const PCB& process) {
+		return process.state == State::E || process.all_time <= 0;
+		}), process_list.end());
+	std::stable_sort(process_list.begin(), process_list.end(), [](const PCB& a, const PCB& b) {
+		return a.arrival < b.arrival;
+		});
+	return std::make_shared<const std::vector<PCB>>(std::move(process_list));
+}
+
+bool SharedSource::next(PCB& process) {
+	if (cursor >= workload->size()) return false;
+	process = (*workload)[cursor++];
+	return true;
+}
+
+bool SharedSource::skip(uint64_t n) {
+	if (n > workload->size() - cursor) return false;
+	cursor += static_cast<size_t>(n);
+	return true;
+}
+
+PolicyComparison::PolicyComparison(SharedWorkload workload, const std::vector<std::string>& policies,
+	const PolicyConfig& policy_config, const SimConfig& sim_config) : workload(std::move(workload)) {
+	for (const auto& policy : policies) {
+		std::unique_ptr<Lane> lane = std::make_unique<Lane>();
+		lane->source = std::make_unique<SharedSource>(this->workload);
+		lane->sim = make_simulator(policy, policy_config, lane->slots, sim_config, lane->source.get());
+		if (!lane->sim) {
+			std::cerr << "Unknown policy: " << policy << std::endl;
+			continue;
+		}
+		lanes.push_back(std::move(lane));
+	}
+	// ȫ߳ lanes ٱ仯
+	for (auto& lane : lanes) {
+		Lane* p = lane.get();
+		p->worker = std::thread([this, p] { run(*p); });
+	}
+}
+
+PolicyComparison::~PolicyComparison() {
+	stop();
+	wait();
+}
+
+bool PolicyComparison::done() {
+	for (auto& lane : lanes) {
+		if (!lane->progress.read().done) return false;
+	}
+	return true;
+}
+
+void PolicyComparison::wait() {
+	for (auto& lane : lanes) {
+		if (lane->worker.joinable()) lane->worker.join();
+	}
+}
+
+void PolicyComparison::stop() {
+	stopping.store(true, std::memory_order_relaxed);
+}
+
+void PolicyComparison::run(Lane& lane) {
+	using Clock = std::chrono::steady_clock;
+	AnySimulator& sim = *lane.sim;
+	Clock::time_point begin = Clock::now();
+	Clock::time_point next_publish = begin;
+
+	auto publish = [&](bool done) {
+		ComparisonProgress& progress = lane.progress.write_buffer();
+		progress.policy = sim.name();
+		progress.stats = sim.stats();
+		progress.status = sim.status();
+		progress.latency = sim.latency();
+		progress.wall_seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+		progress.done = done;
+		lane.progress.publish();
+	};
+
+	// ÿ 4096 ¼һʱӺֹͣ־
+	bool more = true;
+	while (more && !stopping.load(std::memory_order_relaxed)) {
+		for (int i = 0; i < 4096 && (more = sim.step()); ++i) {}
+		if (Clock::now() >= next_publish) {
+			publish(false);
+			next_publish = Clock::now() + PUBLISH_INTERVAL;
+		}
+	}
+	publish(!more);
+}
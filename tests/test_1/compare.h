@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+#include "policies.h"
+#include "triple_buffer.h"
+
+// ֻĸأʱź򡣶ģһ SharedSource ʽȡرֻһ
+using SharedWorkload = std::shared_ptr<const std::vector<PCB>>;
+
+// ȥѽḶ̌ʱȶ󽻳Ȩ
+SharedWorkload share_workload(std::vector<PCB> process_list);
+
+class SharedSource : public WorkloadSource {
+public:
+	explicit SharedSource(SharedWorkload workload) : workload(std::move(workload)) {}
+
+	size_t size() const override { return workload->size(); }
+	bool next(PCB& process) override;
+	bool skip(uint64_t n) override;
+
+private:
+	SharedWorkload workload;
+	size_t cursor = 0;
+};
+
+// һԵ½ȣģ̷߳
+struct ComparisonProgress {
+	std::string policy;
+	SimStats stats;
+	ProcessStatus status;
+	LatencyHistograms latency;
+	double wall_seconds = 0;
+	bool done = false;
+};
+
+// ͬһݸͬʱܶԣÿһ̡߳ģֻԼĽ̲λֻϵͳеḶ̌
+// ͨ SharedSource ֻģ̴߳Լÿ PUBLISH_INTERVAL ѽдԵ壬
+// ߳ʱȡµһݣ˫ȴʱûû߳ͣ²˳
+class PolicyComparison {
+public:
+	static constexpr std::chrono::milliseconds PUBLISH_INTERVAL{ 16 };
+
+	// ֲʶĲ
+	PolicyComparison(SharedWorkload workload, const std::vector<std::string>& policies,
+		const PolicyConfig& policy_config = PolicyConfig(), const SimConfig& sim_config = SimConfig());
+	~PolicyComparison();
+
+	PolicyComparison(const PolicyComparison&) = delete;
+	PolicyComparison& operator=(const PolicyComparison&) = delete;
+
+	size_t size() const { return lanes.size(); }
+	const ComparisonProgress& progress(size_t i) { return lanes[i]->progress.read(); } //ֻһ̵߳
+	bool done();    //вԶ
+	void wait();    //в
+	void stop();    //ûûĲͣ
+
+private:
+	struct Lane {
+		std::unique_ptr<AnySimulator> sim;
+		std::vector<PCB> slots;
+		std::unique_ptr<SharedSource> source;
+		TripleBuffer<ComparisonProgress> progress;
+		std::thread worker;
+	};
+
+	void run(Lane& lane);
+
+	SharedWorkload workload;
+	std::vector<std::unique_ptr<Lane>> lanes;
+	std::atomic<bool> stopping{ false };
+};
@@ -0,0 +1,81 @@
+#include "engine.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "engine_impl.h"
+
+void EventQueue::push(double_t time, EventType type, int32_t id, uint32_t generation) {
+	Event e;
+	e.time = time;
+	e.type = type;
+	e.id = id;
+	e.generation = generation;
+	e.seq = next_seq++;
+	events.push_back(e);
+	std::push_heap(events.begin(), events.end(), Later());
+}
+
+Event EventQueue::pop() {
+	std::pop_heap(events.begin(), events.end(), Later());
+	Event e = events.back();
+	events.pop_back();
+	return e;
+}
+
+void EventQueue::clear() {
+	events.clear();
+	next_seq = 0;
+}
+
+void EventQueue::save(SnapshotWriter& out) const {
+	out.put_array(events);
+	out.put(next_seq);
+}
+
+bool EventQueue::load(SnapshotReader& in) {
+	return in.get_array(events) && in.get(next_seq);
+}
+
+void LatencyHistograms::record(const PCB& process) {
+	turnaround.record(process.finish_time - process.arrival);
+	waiting.record(process.finish_time - process.arrival - process.burst - process.io_wait);
+	response.record(process.first_run - process.arrival);
+}
+
+void LatencyHistograms::merge(const LatencyHistograms& other) {
+	turnaround.merge(other.turnaround);
+	waiting.merge(other.waiting);
+	response.merge(other.response);
+}
+
+void LatencyHistograms::clear() {
+	turnaround.clear();
+	waiting.clear();
+	response.clear();
+}
+
+void LatencyHistograms::save(SnapshotWriter& out) const {
+	turnaround.save(out);
+	waiting.save(out);
+	response.save(out);
+}
+
+bool LatencyHistograms::load(SnapshotReader& in) {
+	return turnaround.load(in) && waiting.load(in) && response.load(in);
+}
+
+double_t slowdown_fairness(const std::vector<PCB>& process_list) {
+	double_t sum = 0, sum_sq = 0;
+	size_t n = 0;
+	for (const auto& process : process_list) {
+		if (process.state != State::E || process.burst <= 0) continue;
+		double_t slowdown = (process.finish_time - process.arrival) / process.burst;
+		sum += slowdown;
+		sum_sq += slowdown * slowdown;
+		n++;
+	}
+	return sum_sq > 0 ? sum * sum / (n * sum_sq) : 1;
+}
+
+template class BasicSimulator<Scheduler>;
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../common/replay.h"
+#include "../common/snapshot.h"
+#include "histogram.h"
+#include "intrusive_list.h"
+#include "pcb.h"
+
+class Timeline;
+
+enum class EventType : int {
+	Arrival = 1,  //̵
+	SliceEnd = 2, //ʱƬꡢн I/O
+	IoDone = 3    //豸һ I/O̻ص̬
+};
+
+struct Event {
+	double_t time = 0;
+	EventType type = EventType::Arrival;
+	int32_t id = -1;         // process_list е±
+	uint32_t generation = 0; //SliceEnd ãռ¼
+	uint64_t seq = 0;        //ͬһʱ̰˳
+};
+
+// ¼ (time, seq) Сѡֱӷ vector ʱԭ
+class EventQueue {
+public:
+	void push(double_t time, EventType type, int32_t id, uint32_t generation = 0);
+	Event pop();
+
+	const Event& top() const { return events.front(); }
+	bool empty() const { return events.empty(); }
+	size_t size() const { return events.size(); }
+	void clear();
+
+	void save(SnapshotWriter& out) const;
+	bool load(SnapshotReader& in);
+
+private:
+	struct Later {
+		bool operator()(const Event& a, const Event& b) const {
+			return a.time > b.time || (a.time == b.time && a.seq > b.seq);
+		}
+	};
+
+	std::vector<Event> events;
+	uint64_t next_seq = 0;
+};
+
+constexpr double_t RUN_TO_END = std::numeric_limits<double_t>::infinity();
+
+// ȲԽӿڡ渺ƽʱʹ¼ĸ̡жɲԾ
+class Scheduler {
+public:
+	virtual ~Scheduler() {}
+
+	virtual const char* name() const = 0;
+	virtual void reset(std::vector<PCB>& process_list) = 0;
+
+	virtual void on_arrival(int32_t id, double_t now) = 0;          //̬̽
+	virtual int32_t pick_next(double_t now) = 0;                    //ȡһеḶ̌-1 ʾûо
+	virtual double_t time_slice(int32_t id, double_t now) = 0;      //жãRUN_TO_END ʾ
+	virtual void on_run(int32_t id, double_t ran, double_t now) {}  //̸ ranPCB Ѹ
+	virtual void on_requeue(int32_t id, double_t now) = 0;          //ʱƬռ¾
+	virtual void on_finish(int32_t id, double_t now) {}
+	virtual void on_block(int32_t id, double_t now) {}                           //̷ I/O 뿪 CPUپ
+	virtual void on_wakeup(int32_t id, double_t now) { on_arrival(id, now); }   //I/O ɣ¾
+
+	// н̵ʱѯǷϵǰµȣµȿѡ
+	virtual bool should_preempt(int32_t running, int32_t arrived, double_t now) { return false; }
+
+	// ֻб仯״̬ԿԻֲָͬͬϣ绻һʱƬ
+	// load  reset ֮ã̱Ѿָ
+	virtual void save(SnapshotWriter& out) const {}
+	virtual bool load(SnapshotReader& in) { return in.ok(); }
+};
+
+// ʱ˳ṩ̵ĸԴڴӳ trace ļҪʱȡһ
+class WorkloadSource {
+public:
+	virtual ~WorkloadSource() {}
+
+	virtual size_t size() const = 0;     //
+	virtual bool next(PCB& process) = 0; //ȡһ̣ʱ䲻ȡʱ false
+
+	//  n ̣ӿջָʱãʵĸԴֱƶλ
+	virtual bool skip(uint64_t n) {
+		PCB process(0, 0, 0, 0, State::R);
+		for (uint64_t i = 0; i < n; ++i) {
+			if (!next(process)) return false;
+		}
+		return true;
+	}
+};
+
+// I/O ʱķֲֵȡ̵ io_time
+enum class ServiceDistribution : int {
+	Fixed = 1,       //Ϊֵ
+	Exponential = 2, //ϵ 1ʵĴ
+	LogNormal = 3    //ϵ cv ָβ
+};
+
+struct DeviceConfig {
+	ServiceDistribution distribution = ServiceDistribution::Exponential;
+	double_t cv = 1; //LogNormal ıϵ׼ / ֵ
+};
+
+struct SimConfig {
+	double_t context_switch = 0; //ÿλϲͬĽʱ CPU лϵʱ䣬ڼ䲻ƽκν
+	std::vector<DeviceConfig> devices = { DeviceConfig() }; // I/O 豸̵ device 豸ȡģÿ豸ȷ
+	uint64_t io_seed = 1;        //ʱ
+};
+
+// 豸ͳ
+struct DeviceStats {
+	size_t requests = 0;     //ɵ I/O 
+	double_t busy_time = 0;  // I/O ķʱ֮
+	size_t max_queue = 0;    //Ŷӽڷģ
+};
+
+// нֹʱҵ lateness / Խֹʱ Ͱ i ͰΪ (EDGES[i-1], EDGES[i]]һͰûϽ
+constexpr size_t LATENESS_BUCKETS = 10;
+constexpr double_t LATENESS_EDGES[LATENESS_BUCKETS - 1] = { -0.75, -0.5, -0.25, 0, 0.25, 0.5, 1, 2, 4 };
+
+struct SimStats {
+	double_t now = 0;              //ǰģʱ
+	double_t busy_time = 0;        //CPU æµʱ
+	size_t events = 0;             //Ѵ¼
+	size_t dispatches = 0;         //ȴ
+	size_t context_switches = 0;   //ϵĽһͬ
+	double_t switch_time = 0;      //лϵʱ䣬 busy_time
+	size_t finished = 0;           //ɽ
+	double_t total_turnaround = 0;
+	double_t total_waiting = 0;
+	double_t total_response = 0;
+	double_t total_slowdown = 0;    //תʱ / ʱ䣬ʽ½̱ѽ̣ƽָֻۼ
+	double_t total_slowdown_sq = 0;
+
+	size_t deadline_jobs = 0;      //ѽнֹʱҵ
+	size_t deadline_misses = 0;    //ʱڽֹʱ
+	double_t total_tardiness = 0;  //ֹʱĲ֮
+	double_t max_lateness = -std::numeric_limits<double_t>::infinity();
+	std::array<size_t, LATENESS_BUCKETS> lateness_buckets = {};
+
+	size_t io_requests = 0;        //ɵ I/O 
+	double_t io_busy_time = 0;     //豸ķʱ֮
+	double_t blocked_time = 0;     //ŶӼӷ񣩵ʱ֮
+
+	double_t utilization() const { return now > 0 ? busy_time / now : 0; }
+	double_t avg_turnaround() const { return finished ? total_turnaround / finished : 0; }
+	double_t avg_waiting() const { return finished ? total_waiting / finished : 0; }
+	double_t avg_response() const { return finished ? total_response / finished : 0; }
+	double_t throughput() const { return now > 0 ? finished / now : 0; }
+	double_t miss_ratio() const { return deadline_jobs ? static_cast<double_t>(deadline_misses) / deadline_jobs : 0; }
+	double_t io_utilization(size_t devices) const { return now > 0 && devices ? io_busy_time / (now * devices) : 0; }
+	double_t fairness() const { return total_slowdown_sq > 0 ? total_slowdown * total_slowdown / (finished * total_slowdown_sq) : 1; }
+};
+
+// ѽ̵ʱӷֲ SimStats ƽֵӦŽ SimStatsֱͼмʮ KB
+//  SimStats ֵƣ run_realtime ƣ
+struct LatencyHistograms {
+	LatencyHistogram turnaround;
+	LatencyHistogram waiting;
+	LatencyHistogram response;
+
+	void record(const PCB& process);  //process ѽ
+	void merge(const LatencyHistograms& other);
+	void clear();
+
+	void save(SnapshotWriter& out) const;
+	bool load(SnapshotReader& in);
+};
+
+// ѽ slowdownתʱ / ʱ䣩 Jain ƽָ1 ʾȫƽ
+double_t slowdown_fairness(const std::vector<PCB>& process_list);
+
+// ¼־һ¼24 ֽ
+struct EventRecord {
+	double_t time = 0;
+	EventType type = EventType::Arrival;
+	int32_t id = -1;       //¼漰Ľ±
+	int32_t running = -1;  //¼ĵȣеḶ̌-1 ʾ
+	uint32_t reserved = 0;
+};
+
+static_assert(sizeof(EventRecord) == 24, "EventRecord layout");
+
+// ģ̵ļ¼ÿһ¼λ׷һ¼ڴ棻
+// ʱؼֻ֡ĹĽ̵֡ģʱļٷֵ㡣
+//  k ؼ֡¼ŶӦǴǰ index ¼ʱ״̬
+struct SimRecorder {
+	EventRing<EventRecord> events;
+	KeyframeStore keyframes;
+
+	explicit SimRecorder(size_t capacity = size_t(1) << 16, uint64_t keyframe_memory = KeyframeStore::DEFAULT_MEMORY_LIMIT) :
+		events(capacity), keyframes(SNAPSHOT_SCHEDULER, keyframe_memory) {}
+
+	void clear() {
+		events.clear();
+		keyframes.clear();
+	}
+};
+
+// ȲԵıԼ߱ Scheduler ȫԱҪ̳ Scheduler
+// on_run ൱λģ on_tickֻһαеһΡ
+template <typename Policy, typename = void>
+struct is_scheduler_policy : std::false_type {};
+
+template <typename Policy>
+struct is_scheduler_policy<Policy, std::void_t<
+	decltype(std::declval<const Policy&>().name()),
+	decltype(std::declval<Policy&>().reset(std::declval<std::vector<PCB>&>())),
+	decltype(std::declval<Policy&>().on_arrival(int32_t(), double_t())),
+	decltype(static_cast<int32_t>(std::declval<Policy&>().pick_next(double_t()))),
+	decltype(static_cast<double_t>(std::declval<Policy&>().time_slice(int32_t(), double_t()))),
+	decltype(std::declval<Policy&>().on_run(int32_t(), double_t(), double_t())),
+	decltype(std::declval<Policy&>().on_requeue(int32_t(), double_t())),
+	decltype(std::declval<Policy&>().on_finish(int32_t(), double_t())),
+	decltype(std::declval<Policy&>().on_block(int32_t(), double_t())),
+	decltype(std::declval<Policy&>().on_wakeup(int32_t(), double_t())),
+	decltype(static_cast<bool>(std::declval<Policy&>().should_preempt(int32_t(), int32_t(), double_t()))),
+	decltype(std::declval<const Policy&>().save(std::declval<SnapshotWriter&>())),
+	decltype(static_cast<bool>(std::declval<Policy&>().load(std::declval<SnapshotReader&>())))>> : std::true_type {};
+
+// ɢ¼ģ⣺ֱһ¼ʱ̣ģʱȾ֡޹ء
+// ʵPolicy Ϊ final ʱ¼ѭԲԵĵöֱӵã
+// Policy Ϊ Scheduler ʱͨ麯ãڲȷԣSimulator
+// Ա engine_impl.h УֻõĲʽʵ
+template <typename Policy>
+class BasicSimulator {
+	static_assert(is_scheduler_policy<Policy>::value, "Policy must provide the Scheduler member functions");
+
+public:
+	BasicSimulator(std::vector<PCB>& process_list, Policy& scheduler, const SimConfig& config = SimConfig());
+	// ʽأprocess_list ֻѵδḶ̌Ĳλø֮󵽴Ḷ̌
+	// ڴͬʱϵͳеĽȣ븺ܳ޹
+	BasicSimulator(std::vector<PCB>& process_list, Policy& scheduler, WorkloadSource& source,
+		const SimConfig& config = SimConfig());
+
+	void reset();
+	bool step();                   //һ¼û¼ʱ false
+	void run();                    //ен̽
+	void run_until(double_t time); // time ֮ǰ¼
+	void run_before(double_t time); // time ֮ǰ¼ٰʱƽ time
+
+	bool finished() const { return calendar.empty() && current < 0; }
+	double_t now() const { return sim_stats.now; }
+	int32_t running() const { return current; }
+	int32_t last_running() const { return last_run; } //ϴεȵĽ±꣬ٵлλúΪ -1
+	double_t running_since() const { return run_start; } //е㣬 now ʾл
+	double_t slice_left() const { return run_left; }      //н̱ʱƬʣ
+	const SimStats& stats() const { return sim_stats; }
+	const LatencyHistograms& latency() const { return latency_stats; }
+	ProcessStatus status() const;  //O(1)ɨ̱
+
+	const std::vector<DeviceStats>& device_stats() const { return io_stats; }
+
+	// ¼ÿʵУ±ꡢֹʱ̣ͼʹãnullptr ʾ¼
+	void set_timeline(Timeline* timeline) { this->timeline = timeline; }
+
+	// ӵǰ״̬ʼ¼ recorder һؼ֡nullptr ʾֹͣ¼
+	void set_recorder(SimRecorder* recorder);
+
+	// գ̱¼豸СͳƺͲԵȫ״̬ SimConfig ͸ͼ
+	// load Ҫࡢ豸Ƿʽ뱣ʱͬлʱƬԲͬ
+	// һԤȵ״̬˿Էֲ塣ʽ¸Դͷ򿪣load ȡĽ̡
+	// ʧʱ falseģ״̬ٿã reset
+	void save(SnapshotWriter& out) const;
+	bool load(SnapshotReader& in);
+	// һؼ֡¼ʱдģֻһؼ֮֡ĹḶ̌ load ؼ֡
+	// ٰ˳ӣмֻ֡ϸĹḶ̌processes_onlyһ֡ٻָ״̬
+	bool load_delta(SnapshotReader& in, bool processes_only);
+
+private:
+	void schedule_next_arrival();
+	void sync_running(bool slice_done = false);
+	void stop_running();
+	void record_deadline(const PCB& process);
+	void dispatch();
+	void block();                   //ǰ̷ I/O
+	void start_io(size_t device);   //豸Ŷʱʼ
+	size_t device_of(const PCB& process) const;
+	void complete_io(int32_t id);
+
+	// ¼ʱǸĹĽ̡һ¼ֻ¼Ľ̡еĽ̺µḶ̌
+	// ¼Ľ step ͷǣеĽ dispatch ʱÿؼ֮֡ǣָ֡屣
+	void touch(int32_t id);
+	uint64_t keyframe_bytes() const;
+	void save_keyframe(uint64_t index);
+	void save_delta(SnapshotWriter& out);
+	void save_state(SnapshotWriter& out) const; //̱ȫ״̬
+	bool load_source(SnapshotReader& in);       //ͷǷʽʽʱȡĽ
+	bool load_state(SnapshotReader& in);
+
+	std::vector<PCB>& process_list;
+	Policy& scheduler;
+	WorkloadSource* source = nullptr;
+	SimConfig config;
+	Timeline* timeline = nullptr;
+	SimRecorder* recorder = nullptr;
+	std::vector<uint64_t> dirty_bits;  //һؼ֮֡ĹĽ
+	std::vector<int32_t> dirty;
+	std::vector<PCB> delta_pcbs;       //֡ݴ
+	std::vector<int32_t> delta_links;  //ָ֡룬дʹòٷ
+	bool rebase = true;                //һؼ֡ģտʼ¼գ
+	EventQueue calendar;
+
+	std::vector<int32_t> arrival_order; //ʱ±꣬¼
+	size_t next_arrival = 0;
+	size_t arrived = 0;
+	size_t finished_before = 0; //reset ʱѾĽ
+	std::vector<int32_t> free_slots; //ʽ¿ɸõĲλ
+	uint64_t pulled = 0;             //ѴӸԴȡĽ
+
+	// 豸 PCB::prev/next ӵʽѶڴ
+	struct IoDevice {
+		ProcessList queue;
+		int32_t serving = -1;  //ڷḶ̌-1 ʾ
+		double_t started = 0;  //ηʼʱ
+	};
+	std::vector<IoDevice> io_devices;
+	std::vector<DeviceStats> io_stats;
+	std::mt19937_64 io_gen;
+
+	int32_t current = -1;     //еĽ±
+	int32_t last_run = -1;
+	double_t run_start = 0;   //е㣨sync_running ǰƣлʱ dispatch ʱ֮
+	double_t run_left = 0;    //ʱƬʣ೤
+	double_t slice_start = 0; //εʵʿʼеʱ
+	uint32_t generation = 0;
+
+	SimStats sim_stats;
+	LatencyHistograms latency_stats;
+};
+
+//  view ָǰ index ¼ʱ״̬ǰؼ֡ӵ index Ϊֹ֡
+// ¼طţ۲ؼ֡һؼ֡
+// ģȷԵģ״̬Ҳڿط뵱ʱȫһ¡
+// view 뱻¼ģࡢ豸ǷʽͬʽʱԴͷ򿪣¼
+template <typename Sim>
+bool replay_to(const SimRecorder& recorder, Sim& view, uint64_t index) {
+	const Keyframe* frame = recorder.keyframes.at_or_before(index);
+	if (!frame || index > recorder.events.size()) return false;
+
+	const Keyframe* base = recorder.keyframes.base_of(*frame);
+	SnapshotReader in = recorder.keyframes.open(*base);
+	if (!view.load(in)) return false;
+	for (const Keyframe* k = base + 1; k <= frame; ++k) {
+		SnapshotReader delta = recorder.keyframes.open(*k);
+		if (!view.load_delta(delta, k != frame)) return false;
+	}
+	for (uint64_t i = frame->index; i < index; ++i) {
+		if (!view.step()) return false;
+	}
+	return true;
+}
+
+using Simulator = BasicSimulator<Scheduler>;
+extern template class BasicSimulator<Scheduler>;
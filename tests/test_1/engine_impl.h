@@ -0,0 +1,522 @@
+#pragma once
+
+// BasicSimulator ĳԱ塣ֻʽʵڵԴļengine.cpp ʵ Scheduler
+// policies.cpp ʵԣطͨ extern template ʹãظ档
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "engine.h"
+#include "timeline.h"
+
+template <typename Policy>
+BasicSimulator<Policy>::BasicSimulator(std::vector<PCB>& process_list, Policy& scheduler, const SimConfig& config) :
+	process_list(process_list), scheduler(scheduler), config(config) {
+	reset();
+}
+
+template <typename Policy>
+BasicSimulator<Policy>::BasicSimulator(std::vector<PCB>& process_list, Policy& scheduler, WorkloadSource& source,
+	const SimConfig& config) :
+	process_list(process_list), scheduler(scheduler), source(&source), config(config) {
+	reset();
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::reset() {
+	calendar.clear();
+	if (source) process_list.clear();
+	free_slots.clear();
+	pulled = 0;
+	scheduler.reset(process_list);
+	sim_stats = SimStats();
+	latency_stats.clear();
+	current = -1;
+	last_run = -1;
+	generation = 0;
+	rebase = true;
+
+	size_t devices = std::max<size_t>(config.devices.size(), 1);
+	io_devices.assign(devices, IoDevice{ ProcessList(&process_list) });
+	io_stats.assign(devices, DeviceStats());
+	io_gen.seed(config.io_seed);
+
+	// ϴ̬ͣĽ´Ӿʼ
+	arrival_order.clear();
+	for (size_t i = 0; i < process_list.size(); ++i) {
+		PCB& process = process_list[i];
+		if (process.state == State::B) process.state = State::R;
+		if (process.state == State::R && process.all_time > 0) arrival_order.push_back(static_cast<int32_t>(i));
+	}
+	std::stable_sort(arrival_order.begin(), arrival_order.end(), [this](int32_t a, int32_t b) {
+		return process_list[a].arrival < process_list[b].arrival;
+		});
+	next_arrival = 0;
+	arrived = 0;
+	finished_before = process_list.size() - arrival_order.size();
+	schedule_next_arrival();
+}
+
+template <typename Policy>
+ProcessStatus BasicSimulator<Policy>::status() const {
+	ProcessStatus status;
+	status.total = source ? source->size() : process_list.size();
+	status.finished = finished_before + sim_stats.finished;
+	status.runnable = arrived - sim_stats.finished;
+	status.now = sim_stats.now;
+	return status;
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::schedule_next_arrival() {
+	if (source) {
+		PCB process(0, 0, 0, 0, State::R);
+		if (!source->next(process)) return;
+		pulled++;
+
+		int32_t id;
+		if (!free_slots.empty()) {
+			id = free_slots.back();
+			free_slots.pop_back();
+			process_list[id] = process;
+			if (id == last_run) last_run = -1; //λ˽̣ٵҲл
+		}
+		else {
+			id = static_cast<int32_t>(process_list.size());
+			process_list.push_back(process);
+		}
+		touch(id);
+		calendar.push(std::max(process.arrival, sim_stats.now), EventType::Arrival, id);
+		return;
+	}
+
+	if (next_arrival >= arrival_order.size()) return;
+
+	int32_t id = arrival_order[next_arrival++];
+	calendar.push(std::max(process_list[id].arrival, sim_stats.now), EventType::Arrival, id);
+}
+
+// еĽƽǰʱ
+// slice_done ʱƻĳȽ㣬⸡¼Сʣʱ
+template <typename Policy>
+void BasicSimulator<Policy>::sync_running(bool slice_done) {
+	if (current < 0) return;
+
+	double_t ran = slice_done ? run_left : std::min(sim_stats.now - run_start, run_left);
+	if (ran <= 0) return; // л
+
+	PCB& process = process_list[current];
+	process.run_process(ran);
+	if (process.io_every > 0) process.until_io -= ran;
+	sim_stats.busy_time += ran;
+	run_left -= ran;
+	run_start = sim_stats.now;
+	scheduler.on_run(current, ran, sim_stats.now);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::record_deadline(const PCB& process) {
+	double_t lateness = process.finish_time - process.deadline;
+	double_t relative = process.deadline - process.arrival;
+	double_t normalized = relative > 0 ? lateness / relative : (lateness > 0 ? RUN_TO_END : 0);
+
+	sim_stats.deadline_jobs++;
+	if (lateness > 1e-9) {
+		sim_stats.deadline_misses++;
+		sim_stats.total_tardiness += lateness;
+	}
+	sim_stats.max_lateness = std::max(sim_stats.max_lateness, lateness);
+	size_t bucket = std::lower_bound(LATENESS_EDGES, LATENESS_EDGES + LATENESS_BUCKETS - 1, normalized - 1e-9) - LATENESS_EDGES;
+	sim_stats.lateness_buckets[bucket]++;
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::stop_running() {
+	PCB& process = process_list[current];
+	if (timeline) timeline->add(current, slice_start, sim_stats.now);
+	if (sim_stats.now < run_start) {
+		// лûɾͱռֻѻлʱ䣬Ҳûʼ
+		sim_stats.switch_time -= run_start - sim_stats.now;
+		if (process.first_run == run_start) {
+			sim_stats.total_response -= process.first_run - process.arrival;
+			process.first_run = -1;
+		}
+	}
+	if (process.state == State::E) {
+		process.finish_time = sim_stats.now;
+		sim_stats.finished++;
+		sim_stats.total_turnaround += process.finish_time - process.arrival;
+		sim_stats.total_waiting += process.finish_time - process.arrival - process.burst - process.io_wait;
+		if (process.burst > 0) {
+			double_t slowdown = (process.finish_time - process.arrival) / process.burst;
+			sim_stats.total_slowdown += slowdown;
+			sim_stats.total_slowdown_sq += slowdown * slowdown;
+		}
+		latency_stats.record(process);
+		if (process.deadline >= 0) record_deadline(process);
+		scheduler.on_finish(current, sim_stats.now);
+		if (source) free_slots.push_back(current);
+	}
+	else if (process.io_every > 0 && process.until_io <= 1e-9) {
+		block();
+	}
+	else {
+		scheduler.on_requeue(current, sim_stats.now);
+	}
+
+	current = -1;
+	generation++;
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::block() {
+	PCB& process = process_list[current];
+	process.state = State::B;
+	process.until_io = process.io_every;
+	process.blocked_at = sim_stats.now;
+	scheduler.on_block(current, sim_stats.now);
+
+	size_t device = device_of(process);
+	IoDevice& io = io_devices[device];
+	io.queue.push_back(current);
+	io_stats[device].max_queue = std::max(io_stats[device].max_queue, io.queue.size() - (io.serving < 0 ? 1 : 0));
+	start_io(device);
+}
+
+template <typename Policy>
+size_t BasicSimulator<Policy>::device_of(const PCB& process) const {
+	int64_t n = static_cast<int64_t>(io_devices.size());
+	return static_cast<size_t>(((process.device % n) + n) % n);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::start_io(size_t device) {
+	IoDevice& io = io_devices[device];
+	if (io.serving >= 0 || io.queue.empty()) return;
+
+	int32_t id = io.queue.pop_front();
+	io.serving = id;
+	io.started = sim_stats.now;
+
+	// ֲֻǼÿΰ̵ľֵֹ죬ڴ
+	double_t mean = std::max(process_list[id].io_time, 0.0);
+	const DeviceConfig& device_config = device < config.devices.size() ? config.devices[device] : DeviceConfig();
+	double_t service = mean;
+	if (mean > 0 && device_config.distribution == ServiceDistribution::Exponential) {
+		service = std::exponential_distribution<double_t>(1 / mean)(io_gen);
+	}
+	else if (mean > 0 && device_config.distribution == ServiceDistribution::LogNormal) {
+		double_t sigma2 = std::log(1 + device_config.cv * device_config.cv);
+		service = std::lognormal_distribution<double_t>(std::log(mean) - sigma2 / 2, std::sqrt(sigma2))(io_gen);
+	}
+	calendar.push(sim_stats.now + service, EventType::IoDone, id);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::complete_io(int32_t id) {
+	PCB& process = process_list[id];
+	size_t device = device_of(process);
+	IoDevice& io = io_devices[device];
+	double_t service = sim_stats.now - io.started;
+	io.serving = -1;
+
+	double_t blocked = sim_stats.now - process.blocked_at;
+	process.state = State::R;
+	process.io_wait += blocked;
+	sim_stats.io_requests++;
+	sim_stats.io_busy_time += service;
+	sim_stats.blocked_time += blocked;
+	io_stats[device].requests++;
+	io_stats[device].busy_time += service;
+	start_io(device);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::dispatch() {
+	int32_t id = scheduler.pick_next(sim_stats.now);
+	if (id < 0) return;
+
+	// ϲͬĽȸл̴лʱʼ
+	double_t overhead = 0;
+	sim_stats.dispatches++;
+	if (id != last_run) {
+		sim_stats.context_switches++;
+		overhead = config.context_switch;
+		sim_stats.switch_time += overhead;
+	}
+
+	PCB& process = process_list[id];
+	touch(id);
+	current = id;
+	last_run = id;
+	run_start = sim_stats.now + overhead;
+	slice_start = run_start;
+	if (process.first_run < 0) {
+		process.first_run = run_start;
+		sim_stats.total_response += process.first_run - process.arrival;
+	}
+	run_left = std::min(scheduler.time_slice(id, sim_stats.now), process.all_time);
+	if (process.io_every > 0) run_left = std::min(run_left, process.until_io); //еһ I/O Ϊֹ
+	calendar.push(run_start + run_left, EventType::SliceEnd, id, generation);
+}
+
+template <typename Policy>
+bool BasicSimulator<Policy>::step() {
+	if (calendar.empty()) return false;
+
+	Event e = calendar.pop();
+	sim_stats.now = e.time;
+	sim_stats.events++;
+	touch(e.id);
+
+	switch (e.type) {
+	case EventType::Arrival:
+		arrived++;
+		schedule_next_arrival();
+		sync_running();
+		if (process_list[e.id].io_every > 0 && process_list[e.id].until_io <= 0) process_list[e.id].until_io = process_list[e.id].io_every;
+		scheduler.on_arrival(e.id, sim_stats.now);
+		if (current >= 0 && scheduler.should_preempt(current, e.id, sim_stats.now)) stop_running();
+		break;
+
+	case EventType::IoDone:
+		complete_io(e.id);
+		sync_running();
+		scheduler.on_wakeup(e.id, sim_stats.now);
+		if (current >= 0 && scheduler.should_preempt(current, e.id, sim_stats.now)) stop_running();
+		break;
+
+	case EventType::SliceEnd:
+		if (e.id != current || e.generation != generation) break; // ѱռľ¼
+		sync_running(true);
+		stop_running();
+		break;
+	}
+
+	// ͬһʱ̵¼ȫٵȣ㳤ȵ
+	if (current < 0 && (calendar.empty() || calendar.top().time > sim_stats.now)) dispatch();
+
+	if (recorder) {
+		EventRecord record;
+		record.time = e.time;
+		record.type = e.type;
+		record.id = e.id;
+		record.running = current;
+		recorder->events.push(record);
+		uint64_t index = recorder->events.size();
+		if (recorder->keyframes.due(index, keyframe_bytes())) save_keyframe(index);
+	}
+
+	return true;
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::set_recorder(SimRecorder* recorder) {
+	this->recorder = recorder;
+	if (!recorder) return;
+
+	recorder->clear();
+	rebase = true;
+	save_keyframe(0);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::touch(int32_t id) {
+	if (!recorder || id < 0) return;
+	size_t word = static_cast<size_t>(id) >> 6;
+	uint64_t bit = uint64_t(1) << (id & 63);
+	if (word >= dirty_bits.size()) dirty_bits.resize(word + 1, 0);
+	if (dirty_bits[word] & bit) return;
+	dirty_bits[word] |= bit;
+	dirty.push_back(id);
+}
+
+// һؼ֡Ĵֽ̱ĹĽ̼ȫָ룬״̬
+template <typename Policy>
+uint64_t BasicSimulator<Policy>::keyframe_bytes() const {
+	if (rebase) return process_list.size() * sizeof(PCB);
+	return dirty.size() * (sizeof(PCB) + sizeof(int32_t)) + process_list.size() * 2 * sizeof(int32_t);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::save_keyframe(uint64_t index) {
+	KeyframeStore& keyframes = recorder->keyframes;
+	bool full = rebase || keyframes.want_full();
+	SnapshotWriter& out = keyframes.begin(index, sim_stats.now, full);
+	if (full) save(out);
+	else save_delta(out);
+	keyframes.end();
+
+	for (int32_t id : dirty) dirty_bits[static_cast<size_t>(id) >> 6] = 0;
+	dirty.clear();
+	rebase = false;
+	touch(current); //еĽ֮¼ﻹᱻ
+}
+
+// ֡ͷλĹḶ̌± PCB 飩ȫλָ룬ͬա
+// ָڽ̳ʱĵڵḶ̌λ屣棬ÿ 8 ֽ
+template <typename Policy>
+void BasicSimulator<Policy>::save_delta(SnapshotWriter& out) {
+	out.put_string(scheduler.name());
+	out.put(source != nullptr);
+	out.put(pulled);
+	out.put(static_cast<uint64_t>(process_list.size()));
+
+	out.put_array(dirty);
+	out.put_selected(process_list, dirty);
+
+	delta_links.resize(process_list.size() * 2);
+	for (size_t i = 0; i < process_list.size(); ++i) {
+		delta_links[2 * i] = process_list[i].prev;
+		delta_links[2 * i + 1] = process_list[i].next;
+	}
+	out.put_array(delta_links);
+	save_state(out);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::save(SnapshotWriter& out) const {
+	out.put_string(scheduler.name());
+	out.put(source != nullptr);
+	out.put(pulled);
+	out.put_array(process_list);
+	save_state(out);
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::save_state(SnapshotWriter& out) const {
+	calendar.save(out);
+	out.put_array(arrival_order);
+	out.put(next_arrival);
+	out.put(arrived);
+	out.put(finished_before);
+	out.put_array(free_slots);
+
+	out.put(io_devices.size());
+	for (const auto& io : io_devices) {
+		io.queue.save(out);
+		out.put(io.serving);
+		out.put(io.started);
+	}
+	out.put_array(io_stats);
+	out.put_engine(io_gen);
+
+	out.put(current);
+	out.put(last_run);
+	out.put(run_start);
+	out.put(run_left);
+	out.put(slice_start);
+	out.put(generation);
+	out.put(sim_stats);
+	latency_stats.save(out);
+	scheduler.save(out);
+}
+
+template <typename Policy>
+bool BasicSimulator<Policy>::load_source(SnapshotReader& in) {
+	std::string name;
+	bool streaming = false;
+	uint64_t saved_pulled = 0;
+	if (!in.get_string(name) || name != scheduler.name()) return in.fail();
+	if (!in.get(streaming) || streaming != (source != nullptr) || !in.get(saved_pulled)) return in.fail();
+
+	// ʱ reset ѾӸԴȡֻ̣ϲ
+	if (source) {
+		if (saved_pulled < pulled || !source->skip(saved_pulled - pulled)) return in.fail();
+		pulled = saved_pulled;
+	}
+	return true;
+}
+
+template <typename Policy>
+bool BasicSimulator<Policy>::load(SnapshotReader& in) {
+	if (!load_source(in)) return false;
+	in.get_array(process_list);
+	rebase = true;
+	return load_state(in);
+}
+
+template <typename Policy>
+bool BasicSimulator<Policy>::load_delta(SnapshotReader& in, bool processes_only) {
+	// м֡Դһ֡һβϲ
+	if (processes_only) {
+		std::string name;
+		bool streaming = false;
+		uint64_t saved_pulled = 0;
+		if (!in.get_string(name) || name != scheduler.name() || !in.get(streaming) || !in.get(saved_pulled)) return in.fail();
+	}
+	else if (!load_source(in)) {
+		return false;
+	}
+
+	// ռõĲλһڸĹĽ
+	uint64_t size = 0;
+	std::vector<int32_t> ids;
+	if (!in.get(size) || !in.get_array(ids) || !in.get_array(delta_pcbs) || ids.size() != delta_pcbs.size() ||
+		size < process_list.size() || size > process_list.size() + ids.size()) return in.fail();
+	process_list.resize(static_cast<size_t>(size), PCB(0, 0, 0, 0, State::E));
+	for (size_t i = 0; i < ids.size(); ++i) {
+		if (ids[i] < 0 || static_cast<uint64_t>(ids[i]) >= size) return in.fail();
+		process_list[ids[i]] = delta_pcbs[i];
+	}
+	rebase = true;
+	if (processes_only) return in.ok();
+
+	if (!in.get_array(delta_links) || delta_links.size() != process_list.size() * 2) return in.fail();
+	for (size_t i = 0; i < process_list.size(); ++i) {
+		process_list[i].prev = delta_links[2 * i];
+		process_list[i].next = delta_links[2 * i + 1];
+	}
+	return load_state(in);
+}
+
+template <typename Policy>
+bool BasicSimulator<Policy>::load_state(SnapshotReader& in) {
+	scheduler.reset(process_list);
+	calendar.load(in);
+	in.get_array(arrival_order);
+	in.get(next_arrival);
+	in.get(arrived);
+	in.get(finished_before);
+	in.get_array(free_slots);
+
+	size_t devices = 0;
+	if (!in.get(devices) || devices != io_devices.size()) return in.fail();
+	for (auto& io : io_devices) {
+		io.queue.load(in);
+		in.get(io.serving);
+		in.get(io.started);
+	}
+	in.get_array(io_stats);
+	if (io_stats.size() != devices) return in.fail();
+	in.get_engine(io_gen);
+
+	in.get(current);
+	in.get(last_run);
+	in.get(run_start);
+	in.get(run_left);
+	in.get(slice_start);
+	in.get(generation);
+	in.get(sim_stats);
+	latency_stats.load(in);
+	return scheduler.load(in) && in.ok();
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::run() {
+	while (step()) {}
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::run_until(double_t time) {
+	while (!calendar.empty() && calendar.top().time <= time) step();
+}
+
+template <typename Policy>
+void BasicSimulator<Policy>::run_before(double_t time) {
+	while (!calendar.empty() && calendar.top().time < time) step();
+	if (time <= sim_stats.now) return;
+	sim_stats.now = time;
+	sync_running();
+}
@@ -0,0 +1,92 @@
+#include "generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+bool parse_burst_distribution(const std::string& name, BurstDistribution& burst) {
+	if (name == "uniform") burst = BurstDistribution::Uniform;
+	else if (name == "exp") burst = BurstDistribution::Exponential;
+	else if (name == "pareto") burst = BurstDistribution::Pareto;
+	else if (name == "lognormal") burst = BurstDistribution::LogNormal;
+	else if (name == "bimodal") burst = BurstDistribution::Bimodal;
+	else {
+		std::cerr << "Unknown burst distribution: " << name << std::endl;
+		return false;
+	}
+	return true;
+}
+
+const char* burst_distribution_name(BurstDistribution burst) {
+	switch (burst) {
+	case BurstDistribution::Uniform: return "uniform";
+	case BurstDistribution::Exponential: return "exp";
+	case BurstDistribution::Pareto: return "pareto";
+	case BurstDistribution::LogNormal: return "lognormal";
+	case BurstDistribution::Bimodal: return "bimodal";
+	}
+	return "";
+}
+
+WorkloadGenerator::WorkloadGenerator(const GeneratorConfig& config) : config(config) {
+	if (this->config.priority_weights.empty()) this->config.priority_weights.push_back(1);
+	priority = std::discrete_distribution<int32_t>(this->config.priority_weights.begin(), this->config.priority_weights.end());
+
+	double_t mean = this->config.mean_burst;
+	double_t alpha = std::max(this->config.pareto_alpha, 1.0 + 1e-6);
+	pareto_scale = mean * (alpha - 1) / alpha;
+	double_t sigma2 = std::log(1 + this->config.lognormal_cv * this->config.lognormal_cv);
+	lognormal_mu = std::log(mean) - sigma2 / 2;
+	lognormal_sigma = std::sqrt(sigma2);
+	short_burst = mean / (1 + this->config.long_fraction * (this->config.long_ratio - 1));
+	rewind();
+}
+
+void WorkloadGenerator::rewind() {
+	gen.seed(config.seed);
+	priority.reset();
+	emitted = 0;
+	arrival = 0;
+}
+
+double_t WorkloadGenerator::draw_burst() {
+	double_t mean = config.mean_burst;
+	switch (config.burst) {
+	case BurstDistribution::Uniform: {
+		int64_t high = std::max<int64_t>(1, std::llround(2 * mean - 1));
+		return static_cast<double_t>(std::uniform_int_distribution<int64_t>(1, high)(gen));
+	}
+	case BurstDistribution::Exponential:
+		return std::exponential_distribution<double_t>(1 / mean)(gen);
+	case BurstDistribution::Pareto: {
+		// 任x_m / U^(1/alpha)U ȡ (0, 1]
+		double_t u = 1 - std::uniform_real_distribution<double_t>(0, 1)(gen);
+		return pareto_scale / std::pow(u, 1 / std::max(config.pareto_alpha, 1.0 + 1e-6));
+	}
+	case BurstDistribution::LogNormal:
+		return std::lognormal_distribution<double_t>(lognormal_mu, lognormal_sigma)(gen);
+	case BurstDistribution::Bimodal: {
+		bool is_long = std::uniform_real_distribution<double_t>(0, 1)(gen) < config.long_fraction;
+		return is_long ? short_burst * config.long_ratio : short_burst;
+	}
+	}
+	return mean;
+}
+
+bool WorkloadGenerator::next(PCB& process) {
+	if (emitted >= config.processes) return false;
+
+	// ÿ̶̹ ȼʱ䡢I/O ˳ȡֻ seed 
+	if (emitted > 0 && config.arrival_rate > 0) arrival += std::exponential_distribution<double_t>(config.arrival_rate)(gen);
+	int32_t prio = priority(gen) + 1;
+	double_t burst = std::max(draw_burst(), config.min_burst);
+	process = PCB(static_cast<int32_t>(emitted + 1), prio, burst, 0, State::R, arrival);
+
+	if (config.io.io_bound > 0 && std::uniform_real_distribution<double_t>(0, 1)(gen) < config.io.io_bound) {
+		process.io_every = config.io.io_every;
+		process.io_time = config.io.io_time;
+		process.device = std::uniform_int_distribution<int32_t>(0, std::max(config.io.devices, 1) - 1)(gen);
+	}
+	emitted++;
+	return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+#include "workload.h"
+
+// ʱķֲֵȡ GeneratorConfig::mean_burst
+enum class BurstDistribution : int {
+	Uniform = 1,     // 1 ~ 2*mean-1 ȷֲֵ 3 ʱ random_workload ͬ
+	Exponential = 2,
+	Pareto = 3,      //״ pareto_alphaԽӽ 1 βԽ
+	LogNormal = 4,   //ϵ lognormal_cv
+	Bimodal = 5      //󲿷Ƕҵlong_fraction ıǳΪ long_ratio ĳҵ
+};
+
+struct GeneratorConfig {
+	uint64_t processes = 1000;
+	uint64_t seed = 1;
+	double_t arrival_rate = 0.25;      //ɵʣÿλʱĽ<= 0 ʱȫ 0 ʱ̵
+	BurstDistribution burst = BurstDistribution::Exponential;
+	double_t mean_burst = 3;
+	double_t min_burst = 0.01;         //̵ķʱص㳤ȵĽ
+	double_t pareto_alpha = 1.5;       // 1ֵ
+	double_t lognormal_cv = 2;
+	double_t long_fraction = 0.1;      //˫ֲгҵı
+	double_t long_ratio = 50;          //ҵҵĳȱ
+	std::vector<double_t> priority_weights = { 1, 1, 1, 1, 1 }; //ȼ 1, 2, ... Ա
+	IoMix io;                          //I/O ͽ̵ıͲĬȫ CPU 
+};
+
+// ֲת"uniform" "exp" "pareto" "lognormal" "bimodal"
+bool parse_burst_distribution(const std::string& name, BurstDistribution& burst);
+const char* burst_distribution_name(BurstDistribution burst);
+
+// ϳɸصʽÿ next ֳһ̣ڴ޹أʮڸҲṹ̱
+// ͬһ seed ʼ mt19937_64ͬһͬһС
+class WorkloadGenerator : public WorkloadSource {
+public:
+	explicit WorkloadGenerator(const GeneratorConfig& config = GeneratorConfig());
+
+	size_t size() const override { return static_cast<size_t>(config.processes); }
+	bool next(PCB& process) override;
+
+	void rewind();  //صһ̣֮ͬһ
+	uint64_t position() const { return emitted; }
+
+private:
+	double_t draw_burst();
+
+	GeneratorConfig config;
+	std::mt19937_64 gen;
+	std::discrete_distribution<int32_t> priority;
+	uint64_t emitted = 0;
+	double_t arrival = 0;
+	double_t pareto_scale = 0;    //x_m = mean * (alpha - 1) / alpha
+	double_t lognormal_mu = 0;
+	double_t lognormal_sigma = 0;
+	double_t short_burst = 0;     //˫ֲĶҵȣʹֵܾ mean_burst
+};
@@ -0,0 +1,426 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "../common/cli.h"
+#include "../common/report.h"
+#include "compare.h"
+#include "engine.h"
+#include "generator.h"
+#include "histogram.h"
+#include "pcb.h"
+#include "policies.h"
+#include "realtime.h"
+#include "sweep.h"
+#include "trace.h"
+#include "workload.h"
+
+// תȴӦʱԵ p50/p90/p99/p999 
+static void add_percentiles(Report& report, const LatencyHistograms& latency) {
+	const std::pair<const char*, const LatencyHistogram*> metrics[] = {
+		{ "turnaround", &latency.turnaround }, { "waiting", &latency.waiting }, { "response", &latency.response } };
+	for (const auto& metric : metrics) {
+		for (size_t i = 0; i < LATENCY_PERCENTILE_COUNT; ++i) {
+			report.add(std::string(metric.first) + "_" + LATENCY_PERCENTILE_NAMES[i], metric.second->percentile(LATENCY_PERCENTILES[i]));
+		}
+	}
+}
+
+// --devices N --io-dist fixed|exp|lognormal --io-cv CVN ֲͬ豸
+static bool parse_devices(const CommandLine& args, SimConfig& config) {
+	DeviceConfig device;
+	std::string dist = args.get("io-dist", "exp");
+	if (dist == "fixed") device.distribution = ServiceDistribution::Fixed;
+	else if (dist == "exp") device.distribution = ServiceDistribution::Exponential;
+	else if (dist == "lognormal") device.distribution = ServiceDistribution::LogNormal;
+	else {
+		std::cerr << "Unknown service distribution: " << dist << std::endl;
+		return false;
+	}
+	device.cv = args.get_number("io-cv", 1);
+	config.devices.assign(static_cast<size_t>(std::max(1.0, args.get_number("devices", 1))), device);
+	config.io_seed = static_cast<uint64_t>(args.get_number("seed", 1));
+	return true;
+}
+
+// ϳɸĲ
+static bool parse_generator(const CommandLine& args, GeneratorConfig& config) {
+	if (!parse_burst_distribution(args.get("burst", "exp"), config.burst)) return false;
+	config.processes = static_cast<uint64_t>(args.get_number("processes", static_cast<double>(config.processes)));
+	config.seed = static_cast<uint64_t>(args.get_number("seed", 1));
+	config.arrival_rate = args.get_number("rate", config.arrival_rate);
+	config.mean_burst = args.get_number("mean-burst", config.mean_burst);
+	config.pareto_alpha = args.get_number("alpha", config.pareto_alpha);
+	config.lognormal_cv = args.get_number("cv", config.lognormal_cv);
+	config.long_fraction = args.get_number("long-fraction", config.long_fraction);
+	config.long_ratio = args.get_number("long-ratio", config.long_ratio);
+	if (args.has("priority-mix")) config.priority_weights = args.get_numbers("priority-mix", "1");
+	config.io.io_bound = args.get_number("io-bound", 0);
+	config.io.io_every = args.get_number("io-every", config.io.io_every);
+	config.io.io_time = args.get_number("io-time", config.io.io_time);
+	config.io.devices = static_cast<int32_t>(args.get_number("devices", 1));
+	if (config.mean_burst <= 0 || (config.burst == BurstDistribution::Pareto && config.pareto_alpha <= 1)) {
+		std::cerr << "--mean-burst must be positive and --alpha greater than 1" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// sjf / srtf ĹƷʽ--predict ָƽԤ⣬ʵ --estimate-error 
+static void parse_sjf(const CommandLine& args, PolicyConfig& config) {
+	config.sjf.predict = args.has("predict");
+	config.sjf.alpha = args.get_number("ewma-alpha", config.sjf.alpha);
+	config.sjf.initial_estimate = args.get_number("tau0", config.sjf.initial_estimate);
+	config.sjf.error_cv = args.get_number("estimate-error", config.sjf.error_cv);
+	config.sjf.seed = static_cast<uint64_t>(args.get_number("seed", 1));
+}
+
+static void usage() {
+	std::cerr << "usage: test_1_headless --workload FILE [--policy NAME] [--quantum Q] [--switch-cost C] [--seed S]"
+		" [--devices N] [--io-dist fixed|exp|lognormal] [--io-cv CV] [--format csv|json] [--output FILE] [--per-process] [--progress]\n";
+	std::cerr << "       test_1_headless --trace FILE [--policy NAME] [--format csv|json] [--output FILE] [--progress]\n";
+	std::cerr << "       test_1_headless --generate [--processes N] [--seed S] [--rate R] [--burst uniform|exp|pareto|lognormal|bimodal]"
+		" [--mean-burst M] [--alpha A] [--cv CV] [--long-fraction F] [--long-ratio K] [--priority-mix W1,W2,...] [--io-bound F]"
+		" [--policy NAME] [--progress]\n";
+	std::cerr << "       checkpoints: [--stop-at T] [--checkpoint SNAPSHOT] [--resume SNAPSHOT]; resume with the same policy and"
+		" device options, and for --trace/--generate the same source options (--workload may be omitted)\n";
+	std::cerr << "       test_1_headless --tasks FILE [--policy edf|rms] [--horizon T] [--no-skip] [--switch-cost C] [--format csv|json] [--output FILE]\n";
+	std::cerr << "       test_1_headless --workload FILE --convert-trace OUT\n";
+	std::cerr << "       test_1_headless --generate-trace OUT [--processes N] [--seed S] [--gap MEAN | --burst DIST ...]\n";
+	std::cerr << "       test_1_headless --sweep [--policies A,B] [--seeds 1-10] [--quanta 1,2,4] [--processes 1000,10000]"
+		" [--gap MEAN] [--switch-cost C] [--warmup T] [--threads N] [--merge-seeds] [--format csv|json] [--output FILE]\n";
+	std::cerr << "       sjf/srtf: [--predict [--ewma-alpha A] [--tau0 T]] [--estimate-error CV]\n";
+	std::cerr << "       test_1_headless --compare A,B,C (--workload FILE | --processes N [--seed S] [--gap MEAN]) [--quantum Q]"
+		" [--switch-cost C] [--format csv|json] [--output FILE]\n";
+	std::cerr << "       sweep I/O mix: [--io-bound 0,0.25,0.5] [--io-every T] [--io-time T] [--devices N] [--io-dist fixed|exp|lognormal] [--io-cv CV]\n";
+	std::cerr << "policies:";
+	for (const auto& name : scheduler_names()) std::cerr << " " << name;
+	std::cerr << std::endl;
+}
+
+// ͬһݸͬʱܶԣÿһֻ̣߳
+static int compare(const CommandLine& args, Report::Format format) {
+	std::vector<PCB> process_list;
+	if (args.has("workload")) {
+		if (!load_workload(args.get("workload"), process_list)) return -1;
+	}
+	else {
+		process_list = random_workload(static_cast<size_t>(args.get_number("processes", 1000)),
+			static_cast<uint32_t>(args.get_number("seed", 1)), args.get_number("gap", 3));
+	}
+	std::vector<std::string> policies = args.get_list("compare", "priority,rr,mlfq");
+	for (const auto& policy : policies) {
+		if (!make_scheduler(policy)) {
+			std::cerr << "Unknown policy: " << policy << std::endl;
+			usage();
+			return -1;
+		}
+	}
+
+	PolicyConfig config;
+	if (args.has("quantum")) set_quantum(config, args.get_number("quantum", 4));
+	config.proportional.seed = static_cast<uint64_t>(args.get_number("seed", 1));
+	parse_sjf(args, config);
+	SimConfig sim_config;
+	sim_config.context_switch = args.get_number("switch-cost", 0);
+
+	PolicyComparison comparison(share_workload(std::move(process_list)), policies, config, sim_config);
+	comparison.wait();
+
+	Report report;
+	for (size_t i = 0; i < comparison.size(); ++i) {
+		const ComparisonProgress& progress = comparison.progress(i);
+		const SimStats& stats = progress.stats;
+		report.begin_row();
+		report.add("policy", progress.policy);
+		report.add("processes", progress.status.total);
+		report.add("finished", stats.finished);
+		report.add("makespan", stats.now);
+		report.add("utilization", stats.utilization());
+		report.add("avg_turnaround", stats.avg_turnaround());
+		report.add("avg_waiting", stats.avg_waiting());
+		report.add("avg_response", stats.avg_response());
+		report.add("throughput", stats.throughput());
+		report.add("fairness", stats.fairness());
+		report.add("context_switches", stats.context_switches);
+		report.add("events", stats.events);
+		add_percentiles(report, progress.latency);
+		report.add("wall_seconds", progress.wall_seconds);
+	}
+	return report.save(args.get("output"), format) ? 0 : -1;
+}
+
+// ɨ裺ÿһģ⣬ܳһű
+static int sweep(const CommandLine& args, Report::Format format) {
+	SweepGrid grid;
+	grid.policies = args.get_list("policies", "priority");
+	for (const auto& policy : grid.policies) {
+		if (!make_scheduler(policy)) {
+			std::cerr << "Unknown policy: " << policy << std::endl;
+			usage();
+			return -1;
+		}
+	}
+	grid.seeds.clear();
+	for (double seed : args.get_numbers("seeds", "1")) grid.seeds.push_back(static_cast<uint32_t>(seed));
+	grid.quanta = args.get_numbers("quanta", "4");
+	grid.process_counts.clear();
+	for (double n : args.get_numbers("processes", "1000")) grid.process_counts.push_back(static_cast<size_t>(n));
+	grid.mean_gap = args.get_number("gap", grid.mean_gap);
+	grid.sim.context_switch = args.get_number("switch-cost", 0);
+	if (!parse_devices(args, grid.sim)) return -1;
+	grid.io_bound = args.get_numbers("io-bound", "0");
+	grid.io.io_every = args.get_number("io-every", grid.io.io_every);
+	grid.io.io_time = args.get_number("io-time", grid.io.io_time);
+	grid.io.devices = static_cast<int32_t>(grid.sim.devices.size());
+	grid.warmup = args.get_number("warmup", 0);
+
+	auto begin = std::chrono::steady_clock::now();
+	std::vector<SweepResult> results = run_sweep(grid, static_cast<size_t>(args.get_number("threads", 0)));
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	std::cerr << results.size() << " simulations in " << seconds << " s" << std::endl;
+
+	// ʧܵϲдͳƱʵʧʱط
+	size_t failed = 0;
+	for (const auto& result : results) {
+		if (result.ok()) continue;
+		std::cerr << "Sweep failed: policy " << result.policy << ", seed " << result.seed << ", quantum " << result.quantum
+			<< ", processes " << result.processes << ", io_bound " << result.io_bound << ": " << result.error << std::endl;
+		failed++;
+	}
+	results.erase(std::remove_if(results.begin(), results.end(), [](const SweepResult& r) { return !r.ok(); }), results.end());
+	if (args.has("merge-seeds")) results = merge_seeds(results);
+
+	Report report;
+	for (const auto& result : results) {
+		report.begin_row();
+		report.add("policy", result.policy);
+		report.add("seed", static_cast<int64_t>(result.seed));
+		if (args.has("merge-seeds")) report.add("seeds", result.seeds);
+		report.add("quantum", result.quantum);
+		report.add("processes", result.processes);
+		report.add("io_bound", result.io_bound);
+		report.add("makespan", result.stats.now);
+		report.add("utilization", result.stats.utilization());
+		report.add("avg_turnaround", result.stats.avg_turnaround());
+		report.add("avg_waiting", result.stats.avg_waiting());
+		report.add("avg_response", result.stats.avg_response());
+		report.add("throughput", result.stats.throughput());
+		report.add("fairness", result.fairness);
+		report.add("context_switches", result.stats.context_switches);
+		report.add("switch_time", result.stats.switch_time);
+		report.add("io_requests", result.stats.io_requests);
+		report.add("io_utilization", result.stats.io_utilization(grid.sim.devices.size()));
+		add_percentiles(report, result.latency);
+		report.add("wall_seconds", result.wall_seconds);
+	}
+	if (!report.save(args.get("output"), format)) return -1;
+	return failed == 0 ? 0 : -1;
+}
+
+// ɵԷģ⵽ horizonͳƽֹʱʧ lateness ֲ
+static int realtime(const CommandLine& args, Report::Format format) {
+	std::vector<PeriodicTask> tasks;
+	if (!load_tasks(args.get("tasks"), tasks)) return -1;
+
+	std::string policy = args.get("policy", "edf");
+	std::unique_ptr<Scheduler> scheduler = make_scheduler(policy);
+	if (!scheduler) {
+		std::cerr << "Unknown policy: " << policy << std::endl;
+		usage();
+		return -1;
+	}
+
+	RealTimeConfig config;
+	config.horizon = args.get_number("horizon", 0);
+	config.skip_repeats = !args.has("no-skip");
+	config.sim.context_switch = args.get_number("switch-cost", 0);
+
+	Schedulability analysis = analyze(tasks);
+	auto begin = std::chrono::steady_clock::now();
+	RealTimeResult result = run_realtime(tasks, *scheduler, config);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	const SimStats& stats = result.stats;
+
+	Report report;
+	report.begin_row();
+	report.add("policy", scheduler->name());
+	report.add("tasks", tasks.size());
+	report.add("task_utilization", analysis.utilization);
+	report.add("liu_layland", analysis.liu_layland);
+	report.add("rms_liu_layland", static_cast<int64_t>(analysis.rms_liu_layland));
+	report.add("rms_response_time", static_cast<int64_t>(analysis.rms_response_time));
+	report.add("edf_test", static_cast<int64_t>(analysis.edf));
+	report.add("hyperperiod", result.hyperperiod);
+	report.add("horizon", stats.now);
+	report.add("jobs", stats.deadline_jobs);
+	report.add("misses", stats.deadline_misses);
+	report.add("miss_ratio", stats.miss_ratio());
+	report.add("max_lateness", stats.deadline_jobs ? stats.max_lateness : 0.0);
+	report.add("total_tardiness", stats.total_tardiness);
+	report.add("pending", result.pending);
+	report.add("utilization", stats.utilization());
+	report.add("context_switches", stats.context_switches);
+	for (size_t i = 0; i < LATENESS_BUCKETS; ++i) {
+		std::ostringstream name;
+		if (i + 1 < LATENESS_BUCKETS) name << "lateness<=" << LATENESS_EDGES[i] << "D";
+		else name << "lateness>" << LATENESS_EDGES[i - 1] << "D";
+		report.add(name.str(), stats.lateness_buckets[i]);
+	}
+	report.add("simulated_windows", result.simulated_windows);
+	report.add("skipped_windows", result.skipped_windows);
+	report.add("wall_seconds", seconds);
+	return report.save(args.get("output"), format) ? 0 : -1;
+}
+
+int main(int argc, char** argv) {
+	CommandLine args(argc, argv);
+
+	Report::Format format = Report::CSV;
+	if (!Report::parse_format(args.get("format", "csv"), format)) {
+		usage();
+		return -1;
+	}
+
+	if (args.has("sweep")) return sweep(args, format);
+	if (args.has("compare")) return compare(args, format);
+	if (args.has("tasks")) return realtime(args, format);
+	if (args.has("generate-trace") && args.has("burst")) {
+		GeneratorConfig generator;
+		if (!parse_generator(args, generator)) return -1;
+		WorkloadGenerator source(generator);
+		return write_trace(args.get("generate-trace"), source) ? 0 : -1;
+	}
+	if (args.has("generate-trace")) {
+		return write_random_trace(args.get("generate-trace"), static_cast<uint64_t>(args.get_number("processes", 1000)),
+			static_cast<uint32_t>(args.get_number("seed", 1)), args.get_number("gap", 2)) ? 0 : -1;
+	}
+	if (!args.has("workload") && !args.has("trace") && !args.has("generate") && !args.has("resume")) {
+		usage();
+		return -1;
+	}
+
+	std::string policy = args.get("policy", "priority");
+	PolicyConfig config;
+	if (args.has("quantum")) set_quantum(config, args.get_number("quantum", 4));
+	config.proportional.seed = static_cast<uint64_t>(args.get_number("seed", 1));
+	parse_sjf(args, config);
+	const std::vector<std::string>& names = scheduler_names();
+	if (std::find(names.begin(), names.end(), policy) == names.end()) {
+		std::cerr << "Unknown policy: " << policy << std::endl;
+		usage();
+		return -1;
+	}
+
+	// trace ģʽ process_list ֻϵͳеĽ̵Ĳλܰ
+	std::vector<PCB> process_list;
+	MappedTrace trace;
+	std::unique_ptr<WorkloadGenerator> generator;
+	WorkloadSource* source = nullptr;
+	bool streaming = args.has("trace") || args.has("generate");
+	if (streaming) {
+		if (args.has("per-process")) {
+			std::cerr << "--per-process is not available with --trace or --generate" << std::endl;
+			return -1;
+		}
+		if (args.has("generate")) {
+			GeneratorConfig generator_config;
+			if (!parse_generator(args, generator_config)) return -1;
+			generator = std::make_unique<WorkloadGenerator>(generator_config);
+			source = generator.get();
+		}
+		else {
+			if (!trace.open(args.get("trace"))) return -1;
+			source = &trace;
+		}
+	}
+	else if (args.has("workload")) {
+		if (!load_workload(args.get("workload"), process_list)) return -1;
+		if (args.has("convert-trace")) return write_trace(args.get("convert-trace"), process_list) ? 0 : -1;
+	}
+
+	SimConfig sim_config;
+	sim_config.context_switch = args.get_number("switch-cost", 0);
+	if (!parse_devices(args, sim_config)) return -1;
+
+	auto begin = std::chrono::steady_clock::now();
+	// ʵ棬¼ѭû
+	std::unique_ptr<AnySimulator> simulator = make_simulator(policy, config, process_list, sim_config, source);
+	AnySimulator& sim = *simulator;
+	if (args.has("resume")) {
+		// ӳֱӶ̱һ
+		MappedSnapshot file;
+		if (!file.open(args.get("resume"))) return -1;
+		SnapshotReader in(file.data(), file.size(), SNAPSHOT_SCHEDULER);
+		if (!sim.load(in)) {
+			std::cerr << "Snapshot does not match this policy, device count and workload: " << args.get("resume") << std::endl;
+			return -1;
+		}
+	}
+	if (args.has("stop-at")) {
+		sim.run_before(args.get_number("stop-at", 0));
+	}
+	else if (args.has("progress")) {
+		// ÿһ¼ڱ׼ϱһΣ O(1) 
+		while (sim.step()) {
+			if (sim.stats().events % 1000000 != 0) continue;
+			ProcessStatus status = sim.status();
+			std::cerr << "t=" << status.now << " runnable=" << status.runnable
+				<< " finished=" << status.finished << "/" << status.total << std::endl;
+		}
+	}
+	else {
+		sim.run();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	if (args.has("checkpoint")) {
+		SnapshotWriter out(SNAPSHOT_SCHEDULER);
+		sim.save(out);
+		if (!out.save(args.get("checkpoint"))) return -1;
+	}
+
+	Report report;
+	if (args.has("per-process")) {
+		for (const auto& process : process_list) {
+			report.begin_row();
+			report.add("pid", process.pid);
+			report.add("arrival", process.arrival);
+			report.add("burst", process.burst);
+			report.add("first_run", process.first_run);
+			report.add("finish", process.finish_time);
+			report.add("turnaround", process.finish_time - process.arrival);
+			report.add("waiting", process.finish_time - process.arrival - process.burst - process.io_wait);
+			report.add("response", process.first_run - process.arrival);
+			report.add("io_wait", process.io_wait);
+		}
+	}
+	else {
+		const SimStats& stats = sim.stats();
+		report.begin_row();
+		report.add("policy", sim.name());
+		report.add("processes", sim.status().total);
+		report.add("finished", stats.finished);
+		report.add("makespan", stats.now);
+		report.add("utilization", stats.utilization());
+		report.add("avg_turnaround", stats.avg_turnaround());
+		report.add("avg_waiting", stats.avg_waiting());
+		report.add("avg_response", stats.avg_response());
+		report.add("throughput", stats.throughput());
+		report.add("fairness", stats.fairness());
+		report.add("context_switches", stats.context_switches);
+		report.add("switch_time", stats.switch_time);
+		report.add("events", stats.events);
+		report.add("io_requests", stats.io_requests);
+		report.add("io_utilization", stats.io_utilization(sim_config.devices.size()));
+		report.add("blocked_time", stats.blocked_time);
+		add_percentiles(report, sim.latency());
+		report.add("wall_seconds", seconds);
+	}
+
+	return report.save(args.get("output"), format) ? 0 : -1;
+}
@@ -0,0 +1,66 @@
+#include "histogram.h"
+
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram(double_t unit) :
+	counts(index_of(MAX_VALUE) + 1, 0), resolution(unit), scale(1 / unit), limit(MAX_VALUE * unit) {}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+	for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+	total += other.total;
+	sum += other.sum;
+	min_value = std::min(min_value, other.min_value);
+	max_value = std::max(max_value, other.max_value);
+}
+
+void LatencyHistogram::clear() {
+	std::fill(counts.begin(), counts.end(), 0);
+	total = 0;
+	sum = 0;
+	min_value = std::numeric_limits<double_t>::infinity();
+	max_value = -std::numeric_limits<double_t>::infinity();
+}
+
+void LatencyHistogram::save(SnapshotWriter& out) const {
+	out.put(resolution);
+	out.put_array(counts);
+	out.put(total);
+	out.put(sum);
+	out.put(min_value);
+	out.put(max_value);
+}
+
+bool LatencyHistogram::load(SnapshotReader& in) {
+	double_t unit = 0;
+	size_t buckets = counts.size();
+	if (!in.get(unit) || unit != resolution) return in.fail();
+	if (!in.get_array(counts) || counts.size() != buckets) {
+		counts.assign(buckets, 0); //Ͱĳ record ʱټ飬ҲҪ
+		return in.fail();
+	}
+	return in.get(total) && in.get(sum) && in.get(min_value) && in.get(max_value);
+}
+
+double_t LatencyHistogram::percentile(double_t p) const {
+	if (total == 0) return 0;
+
+	double_t wanted = std::ceil(std::min(std::max(p, 0.0), 100.0) / 100 * total);
+	uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(wanted));
+	uint64_t seen = 0;
+	for (size_t i = 0; i < counts.size(); ++i) {
+		seen += counts[i];
+		if (seen >= rank) return std::min(std::max(bucket_high(i), min_value), max_value);
+	}
+	return max_value;
+}
+
+uint64_t LatencyHistogram::bucket_start(size_t i) {
+	if (i < SUB_COUNT) return i;
+	uint64_t shift = i / HALF_COUNT - 1;
+	return (i - shift * HALF_COUNT) << shift;
+}
+
+uint64_t LatencyHistogram::bucket_width(size_t i) {
+	if (i < SUB_COUNT) return 1;
+	return uint64_t(1) << (i / HALF_COUNT - 1);
+}
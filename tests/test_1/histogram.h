@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../common/snapshot.h"
+#include "bitops.h"
+#include "pcb.h"
+
+// -ֱͼHdrHistogram ķͰʽֵȰ unit  v
+// v < 2^SUB_BITS ʱÿһͰ֮ÿ [2^k, 2^(k+1)) ȷֳ 2^(SUB_BITS-1) Ͱ
+//  2^-(SUB_BITS-1)Ͱڹʱһηãrecord  O(1) ļλ㣬ڴ档
+// ͰĻֻ unit unit ֱͬͼͰӺϲ
+class LatencyHistogram {
+public:
+	static constexpr int32_t SUB_BITS = 8;
+	static constexpr int32_t MAX_BITS = 42;  //ֵ 2^MAX_BITS - 1 ļһͰ
+	static constexpr uint64_t SUB_COUNT = uint64_t(1) << SUB_BITS;
+	static constexpr uint64_t HALF_COUNT = SUB_COUNT / 2;
+	static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_BITS) - 1;
+
+	explicit LatencyHistogram(double_t unit = 1e-3);
+
+	void record(double_t value) {
+		uint64_t v = 0;
+		if (value >= limit) v = MAX_VALUE;
+		else if (value > 0) v = std::min(static_cast<uint64_t>(value * scale), MAX_VALUE);
+		counts[index_of(v)]++;
+		total++;
+		sum += value;
+		min_value = std::min(min_value, value);
+		max_value = std::max(max_value, value);
+	}
+
+	void merge(const LatencyHistogram& other); //ߵ unit ͬ
+	void clear();
+
+	void save(SnapshotWriter& out) const;
+	bool load(SnapshotReader& in);             //յ unit 뱾ֱͼͬ
+
+	size_t count() const { return total; }
+	double_t unit() const { return resolution; }
+	double_t min() const { return total ? min_value : 0; }
+	double_t max() const { return total ? max_value : 0; }
+	double_t mean() const { return total ? sum / total : 0; }
+
+	//  p ٷλ0~100ͰϽ磬 [min, max] ֮
+	double_t percentile(double_t p) const;
+
+	size_t buckets() const { return counts.size(); }
+	uint64_t bucket_count(size_t i) const { return counts[i]; }
+	double_t bucket_low(size_t i) const { return bucket_start(i) * resolution; }
+	double_t bucket_high(size_t i) const { return (bucket_start(i) + bucket_width(i)) * resolution; }
+
+	static size_t index_of(uint64_t v) {
+		if (v < SUB_COUNT) return static_cast<size_t>(v);
+		int32_t shift = find_last_set(v) - (SUB_BITS - 1);
+		return static_cast<size_t>(shift * HALF_COUNT + (v >> shift));
+	}
+
+private:
+	static uint64_t bucket_start(size_t i);
+	static uint64_t bucket_width(size_t i);
+
+	std::vector<uint64_t> counts;
+	double_t resolution = 1e-3;
+	double_t scale = 1e3;  //1 / unit
+	double_t limit = 0;    //ﵽ MAX_VALUE ֵ
+	size_t total = 0;
+	double_t sum = 0;
+	double_t min_value = std::numeric_limits<double_t>::infinity();
+	double_t max_value = -std::numeric_limits<double_t>::infinity();
+};
+
+// õķλ
+constexpr double_t LATENCY_PERCENTILES[] = { 50, 90, 99, 99.9 };
+constexpr const char* LATENCY_PERCENTILE_NAMES[] = { "p50", "p90", "p99", "p999" };
+constexpr size_t LATENCY_PERCENTILE_COUNT = sizeof(LATENCY_PERCENTILES) / sizeof(LATENCY_PERCENTILES[0]);
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../common/snapshot.h"
+#include "pcb.h"
+
+//  PCB::prev/next Ϊӵ˫ڵǽ±꣬ӳӶڴ
+class ProcessList {
+public:
+	explicit ProcessList(std::vector<PCB>* process_list = nullptr) : process_list(process_list) {}
+
+	bool empty() const { return head < 0; }
+	size_t size() const { return count; }
+	int32_t front() const { return head; }
+
+	void push_back(int32_t id) {
+		PCB& process = (*process_list)[id];
+		process.prev = tail;
+		process.next = -1;
+		if (tail >= 0) (*process_list)[tail].next = id;
+		else head = id;
+		tail = id;
+		count++;
+	}
+
+	int32_t pop_front() {
+		int32_t id = head;
+		erase(id);
+		return id;
+	}
+
+	void erase(int32_t id) {
+		PCB& process = (*process_list)[id];
+		if (process.prev >= 0) (*process_list)[process.prev].next = process.next;
+		else head = process.next;
+		if (process.next >= 0) (*process_list)[process.next].prev = process.prev;
+		else tail = process.prev;
+		process.prev = process.next = -1;
+		count--;
+	}
+
+	//  other ӵĩβO(1)
+	void splice_back(ProcessList& other) {
+		if (other.empty()) return;
+		if (tail >= 0) {
+			(*process_list)[tail].next = other.head;
+			(*process_list)[other.head].prev = tail;
+		}
+		else {
+			head = other.head;
+		}
+		tail = other.tail;
+		count += other.count;
+		other.head = other.tail = -1;
+		other.count = 0;
+	}
+
+	void clear() {
+		head = tail = -1;
+		count = 0;
+	}
+
+	// ӱ PCB ̱һ𱣴棬ֻͷ
+	void save(SnapshotWriter& out) const {
+		out.put(head);
+		out.put(tail);
+		out.put(count);
+	}
+
+	bool load(SnapshotReader& in) {
+		return in.get(head) && in.get(tail) && in.get(count);
+	}
+
+private:
+	std::vector<PCB>* process_list;
+	int32_t head = -1;
+	int32_t tail = -1;
+	size_t count = 0;
+};
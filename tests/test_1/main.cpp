@@ -1,4 +1,7 @@
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <vector>
 
@@ -10,29 +13,34 @@
 #include <imgui/imgui.h>
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
+#include <imgui/implot.h>
+
+#include "compare.h"
+#include "engine.h"
+#include "multicore.h"
+#include "pcb.h"
+#include "policies.h"
+#include "scheduling.h"
+#include "sim_thread.h"
+#include "timeline.h"
+#include "workload.h"
+
+int current_policy = 0; //scheduler_names() е±
+PolicyConfig policy_config;
+SimConfig sim_config;
+Timeline timeline;                     //һеִʷ
+std::vector<PCB> timeline_processes;   // timeline жӦḶ̌ʾ pid
+bool timeline_from_ticks = false;      //ʾλģ̵߳ʱߣһ¼е
+LatencyHistograms latency;             //һ¼УRun to End أʱӷֲ
+bool has_latency = false;
 
-enum class State : int {
-	R = 1,  //
-	E = 2   //
-};
-
-class PCB {
-public:
-	PCB(int32_t pid, int32_t priority, double_t all_time, double_t cpu_time, State state);
-	~PCB();
-
-	bool run_process();
-
-	int32_t pid = 0;        //̱ʶ
-	int32_t priority = 0;   //ȼ
-	double_t all_time = 0;  //̳лҪеʱ
-	double_t cpu_time = 0;  //ռõCPUʱ
-	State state = State::R; //״̬ĬΪ
-};
-
-bool process_finish(std::vector<PCB>& process_list);
-void priority_scheduling_step(std::vector<PCB>& process_list);
 void render_process_list(const std::vector<PCB>& process_list);
+void render_policy_selector();
+std::unique_ptr<AnySimulator> make_selected_simulator(std::vector<PCB>& process_list, const SimConfig& config = sim_config);
+void render_multicore_panel(const std::vector<PCB>& workload);
+void render_compare_panel(const std::vector<PCB>& workload);
+void render_timeline(const SimSnapshot& snapshot);
+void render_latency();
 
 int main() {
     // ʼ
@@ -49,6 +57,11 @@ int main() {
     PCB p5(5, dist_priority(gen), dist_time(gen), 0, State::R);
 
     std::vector<PCB> process_list = { p1, p2, p3, p4, p5 };
+    const std::vector<PCB> workload = process_list; // ʼأģڸ
+
+    // λģڶ߳Уÿֻ֡Ŀ
+    SimThread sim_thread;
+    sim_thread.load(process_list);
 
     // OpenGL  ImGui ʼ
     if (!glfwInit()) {
@@ -63,6 +76,7 @@ int main() {
         return -1;
     }
     glfwMakeContextCurrent(window);
+    glfwSwapInterval(1); // ֱͬ治ٿת
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cerr << "Failed to initialize GLAD" << std::endl;
         return -1;
@@ -70,13 +84,16 @@ int main() {
 
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
+    ImPlot::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     (void)io;
 
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init("#version 330");
 
-    bool simulation_running = false;
+    bool has_stats = false;
+    SimStats last_stats;
+    double_t last_fairness = 1;
 
     // ѭ
     while (!glfwWindowShouldClose(window)) {
@@ -89,18 +106,95 @@ int main() {
 
         // ImGui 
         ImGui::Begin("Priority Scheduling Simulator");
-        render_process_list(process_list);
+        const SimSnapshot& snapshot = sim_thread.snapshot();
+        render_process_list(snapshot.process_list);
 
-        if (ImGui::Button("Start Simulation")) {
-            simulation_running = true;
+        if (ImGui::Button(snapshot.running ? "Pause Simulation" : "Start Simulation")) {
+            if (snapshot.running) sim_thread.pause();
+            else sim_thread.start();
+            timeline_from_ticks = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Step")) {
+            sim_thread.step_once();
+            timeline_from_ticks = true;
+        }
+        ImGui::SameLine();
+        static float speed = 1;
+        static bool fast_forward = false;
+        ImGui::BeginDisabled(fast_forward);
+        ImGui::SetNextItemWidth(200);
+        if (ImGui::SliderFloat("Speed", &speed, 0.1f, 1000, "%.1fx", ImGuiSliderFlags_Logarithmic)) sim_thread.set_speed(speed);
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        // ÿ֡ 12 ms Ԥ߾ܶĲغܿ꣬ճˢ
+        if (ImGui::Checkbox("Fast Forward", &fast_forward)) sim_thread.set_fast_forward(fast_forward);
+        ImGui::Text("Ticks: %llu\tSteps/s: %.0f\tSteps/frame: %llu\tFPS: %.0f", static_cast<unsigned long long>(snapshot.ticks),
+            snapshot.steps_per_second, static_cast<unsigned long long>(snapshot.steps_per_frame), io.Framerate);
+
+        // ϶ؿʷϵһ϶ʱͣLive  Start صǰ״̬
+        uint64_t history_tick = snapshot.ticks;
+        uint64_t history_begin = snapshot.history_begin;
+        uint64_t history_end = std::max(snapshot.live_ticks, history_begin + 1);
+        ImGui::SetNextItemWidth(400);
+        if (ImGui::SliderScalar("History", ImGuiDataType_U64, &history_tick, &history_begin, &history_end)) {
+            sim_thread.scrub(static_cast<int64_t>(std::min(history_tick, snapshot.live_ticks)));
+        }
+        ImGui::SameLine();
+        ImGui::BeginDisabled(!snapshot.scrubbing);
+        if (ImGui::Button("Live")) sim_thread.scrub(-1);
+        ImGui::EndDisabled();
+        if (snapshot.scrubbing) {
+            ImGui::SameLine();
+            ImGui::Text("Viewing tick %llu of %llu", static_cast<unsigned long long>(snapshot.ticks),
+                static_cast<unsigned long long>(snapshot.live_ticks));
         }
-        if (simulation_running && !process_finish(process_list)) {
-            priority_scheduling_step(process_list);
+        if (ImGui::TreeNode("Recent Ticks")) {
+            for (auto it = snapshot.recent.rbegin(); it != snapshot.recent.rend(); ++it) {
+                if (it->id < 0) ImGui::Text("#%llu\tidle\t-> %.0f", static_cast<unsigned long long>(it->tick), it->now);
+                else ImGui::Text("#%llu\tP%d (priority %d)\t-> %.0f", static_cast<unsigned long long>(it->tick),
+                    static_cast<size_t>(it->id) < snapshot.process_list.size() ? snapshot.process_list[it->id].pid : it->id,
+                    it->priority, it->now);
+            }
+            ImGui::TreePop();
         }
-        else if (process_finish(process_list)) {
-            simulation_running = false;
+
+        render_policy_selector();
+        if (ImGui::Button("Run to End (Event-Driven)")) {
+            // ¼Ծƽ֡ƣλģ⵱ǰ״̬ܣٽظģ߳
+            sim_thread.pause();
+            process_list = snapshot.process_list;
+            std::unique_ptr<AnySimulator> sim = make_selected_simulator(process_list);
+            timeline.clear();
+            timeline_processes = process_list;
+            timeline_from_ticks = false;
+            sim->set_timeline(&timeline);
+            sim->run();
+            last_stats = sim->stats();
+            last_fairness = slowdown_fairness(process_list);
+            has_stats = true;
+            latency = sim->latency();
+            has_latency = true;
+            sim_thread.load(process_list);
+        }
+        ImGui::Text("Runnable: %zu\tFinished: %zu / %zu", snapshot.status.runnable, snapshot.status.finished, snapshot.status.total);
+        if (process_finish(snapshot.status)) {
             ImGui::Text("Simulation Complete!");
         }
+        if (has_stats) {
+            ImGui::Text("Simulated Time: %.2f\tEvents: %zu\tContext Switches: %zu",
+                last_stats.now, last_stats.events, last_stats.context_switches);
+            ImGui::Text("Avg Turnaround: %.2f\tAvg Waiting: %.2f\tAvg Response: %.2f",
+                last_stats.avg_turnaround(), last_stats.avg_waiting(), last_stats.avg_response());
+            ImGui::Text("Fairness: %.3f\tThroughput: %.4f", last_fairness,
+                last_stats.throughput());
+            ImGui::Text("Context Switch Time: %.2f (%.1f%%)", last_stats.switch_time,
+                last_stats.now > 0 ? 100 * last_stats.switch_time / last_stats.now : 0.0);
+        }
+        render_multicore_panel(workload);
+        render_compare_panel(workload);
+        render_timeline(snapshot);
+        render_latency();
         ImGui::End();
 
         // Rendering
@@ -118,6 +212,7 @@ int main() {
     // Cleanup
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
+    ImPlot::DestroyContext();
     ImGui::DestroyContext();
     glfwDestroyWindow(window);
     glfwTerminate();
@@ -125,50 +220,362 @@ int main() {
     return 0;
 }
 
-PCB::PCB(int32_t pid, int32_t priority, double_t all_time, double_t cpu_time, State state) :
-	pid(pid), priority(priority), all_time(all_time), cpu_time(cpu_time), state(state) {}
-
-PCB::~PCB() {}
+void render_process_list(const std::vector<PCB>& process_list) {
+	ImGui::Text("process list:");
+	ImGui::Separator();
+	ImGui::Text("PID\tPriority\tCPU Time\tRemaining Time\tState");
+	for (const auto& process : process_list) {
+		ImGui::Text("P%d\t\t%d\t\t%.2f\t\t\t%.2f\t\t\t%s",
+			process.pid, process.priority, process.cpu_time, process.all_time,
+			(process.state == State::R ? "R" : process.state == State::B ? "B" : "E"));
+	}
+	ImGui::Separator();
+}
+void render_policy_selector() {
+	const std::vector<std::string>& names = scheduler_names();
+	ImGui::Combo("Policy", &current_policy, [](void* data, int i) {
+		return (*static_cast<const std::vector<std::string>*>(data))[i].c_str();
+		}, const_cast<std::vector<std::string>*>(&names), static_cast<int>(names.size()));
+
+	if (names[current_policy] == "mlfq") {
+		static int levels = 4;
+		static float base_quantum = 2;
+		static float boost_period = 100;
+		ImGui::SliderInt("Levels", &levels, 1, 16);
+		ImGui::SliderFloat("Base Quantum", &base_quantum, 1, 32, "%.0f");
+		ImGui::SliderFloat("Boost Period", &boost_period, 0, 1000, "%.0f");
+
+		// ÿһʱƬ
+		policy_config.mlfq.quanta.resize(levels);
+		for (int i = 0; i < levels; ++i) policy_config.mlfq.quanta[i] = base_quantum * (1 << i);
+		policy_config.mlfq.boost_period = boost_period;
+	}
+	else if (names[current_policy] == "rr") {
+		ImGui::InputDouble("Quantum", &policy_config.rr.quantum, 1, 4, "%.1f");
+		if (policy_config.rr.quantum < 0.1) policy_config.rr.quantum = 0.1;
+	}
+	else if (names[current_policy] == "stride" || names[current_policy] == "lottery") {
+		// Ʊȡ̵ȼ
+		ImGui::InputDouble("Quantum", &policy_config.proportional.quantum, 1, 4, "%.1f");
+		if (policy_config.proportional.quantum < 0.1) policy_config.proportional.quantum = 0.1;
+	}
 
-bool PCB::run_process() {
-	if (state == State::E || all_time == 0) return false;
+	else if (names[current_policy] == "sjf" || names[current_policy] == "srtf") {
+		// Ԥģʽֻ CPU 䣻ʵ䣬ԼϹ
+		ImGui::Checkbox("Predict Bursts", &policy_config.sjf.predict);
+		if (policy_config.sjf.predict) {
+			ImGui::InputDouble("Alpha", &policy_config.sjf.alpha, 0.1, 0.2, "%.2f");
+			policy_config.sjf.alpha = std::min(1.0, std::max(0.0, policy_config.sjf.alpha));
+			ImGui::InputDouble("Initial Estimate (0 = average)", &policy_config.sjf.initial_estimate, 1, 4, "%.1f");
+		}
+		else {
+			ImGui::InputDouble("Estimate Error (CV)", &policy_config.sjf.error_cv, 0.1, 0.5, "%.2f");
+			if (policy_config.sjf.error_cv < 0) policy_config.sjf.error_cv = 0;
+		}
+	}
 
-	priority--;
-	all_time--;
-	cpu_time++;
+	// лвԶ룬ʱƬԽСлԽƵ
+	ImGui::InputDouble("Context Switch Cost", &sim_config.context_switch, 0.1, 1, "%.2f");
+	if (sim_config.context_switch < 0) sim_config.context_switch = 0;
+}
 
-	if (all_time == 0) state = State::E;
+// ѡеĲԴģ水ʵû
+std::unique_ptr<AnySimulator> make_selected_simulator(std::vector<PCB>& process_list, const SimConfig& config) {
+	return make_simulator(scheduler_names()[current_policy], policy_config, process_list, config);
+}
 
-	return true;
+void render_multicore_panel(const std::vector<PCB>& workload) {
+	static MultiCoreConfig config;
+	static MultiCoreStats stats;
+	static bool has_stats = false;
+
+	if (!ImGui::CollapsingHeader("Multi-Core")) return;
+
+	ImGui::SliderInt("Cores", &config.cores, 1, 64);
+	ImGui::SliderInt("Host Threads (0 = auto)", &config.threads, 0, 64);
+	ImGui::InputDouble("Quantum", &config.quantum, 1, 4, "%.1f");
+	if (config.quantum < 1) config.quantum = 1;
+
+	// ģͣΪ 0 ʱƼʱ䣻Affinity ʱĺŶӹȡ
+	static int placement = 0;
+	ImGui::Combo("Placement", &placement, "Naive\0Affinity\0");
+	config.placement = placement == 0 ? Placement::Naive : Placement::Affinity;
+	if (config.placement == Placement::Affinity) ImGui::SliderInt("Steal Threshold", &config.steal_threshold, 1, 16);
+	ImGui::InputDouble("Cache Size", &config.cache_size, 64, 1024, "%.0f");
+	ImGui::InputDouble("Footprint", &config.footprint, 16, 256, "%.0f");
+	ImGui::InputDouble("Refill Cost", &config.refill_cost, 0.001, 0.01, "%.4f");
+	config.cache_size = std::max(0.0, config.cache_size);
+	config.footprint = std::max(0.0, config.footprint);
+	config.refill_cost = std::max(0.0, config.refill_cost);
+
+	if (ImGui::Button("Run Multi-Core")) {
+		std::vector<PCB> process_list = workload;
+		MultiCoreSim sim(process_list, config);
+		sim.run();
+		stats = sim.stats();
+		has_stats = true;
+	}
+	if (!has_stats) return;
+
+	ImGui::Text("Makespan: %.2f\tMigrations: %zu\tSteals: %zu\tLoad Imbalance: %.3f",
+		stats.now, stats.migrations, stats.steals, stats.load_imbalance());
+	ImGui::Text("Avg Turnaround: %.2f\tAvg Waiting: %.2f", stats.avg_turnaround(), stats.avg_waiting());
+	ImGui::Text("Throughput: %.4f\tWarm-up Time: %.2f\tMigration Penalty: %.2f",
+		stats.throughput(), stats.warmup_time, stats.migration_penalty);
+	if (ImGui::BeginTable("CoreTable", 5, ImGuiTableFlags_Borders)) {
+		ImGui::TableSetupColumn("Core");
+		ImGui::TableSetupColumn("Utilization");
+		ImGui::TableSetupColumn("Dispatches");
+		ImGui::TableSetupColumn("Migrations");
+		ImGui::TableSetupColumn("Steals");
+		ImGui::TableHeadersRow();
+		for (size_t i = 0; i < stats.cores.size(); ++i) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", i);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f%%", stats.utilization(i) * 100);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", stats.cores[i].dispatches);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", stats.cores[i].migrations);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", stats.cores[i].steals);
+		}
+		ImGui::EndTable();
+	}
 }
 
-bool process_finish(std::vector<PCB>& process_list) { //Ƿ
-	for (auto& i : process_list) {
-		if (i.state == State::R) return false;
+// ͬһݸͬʱܼԣԵָ겢ʵʱˢ¡ֻһݣֻ
+void render_compare_panel(const std::vector<PCB>& workload) {
+	static std::unique_ptr<PolicyComparison> comparison;
+	static std::vector<char> selected;
+	static int processes = 100000;
+	static int seed = 1;
+	static bool use_initial = false;
+
+	if (!ImGui::CollapsingHeader("Compare Policies")) return;
+
+	const std::vector<std::string>& names = scheduler_names();
+	if (selected.empty()) {
+		for (const auto& name : names) selected.push_back(name == "priority" || name == "rr" || name == "mlfq" || name == "srtf");
+	}
+	for (size_t i = 0; i < names.size(); ++i) {
+		if (i > 0) ImGui::SameLine();
+		bool on = selected[i] != 0;
+		if (ImGui::Checkbox(names[i].c_str(), &on)) selected[i] = on;
+	}
+	ImGui::Checkbox("Initial Workload", &use_initial);
+	if (!use_initial) {
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(150);
+		ImGui::InputInt("Processes##compare", &processes, 1000, 100000);
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(100);
+		ImGui::InputInt("Seed##compare", &seed);
+		if (processes < 1) processes = 1;
 	}
 
-	return true;
+	bool running = comparison && !comparison->done();
+	if (running) {
+		if (ImGui::Button("Stop Comparison")) comparison.reset();
+	}
+	else if (ImGui::Button("Run Comparison")) {
+		comparison.reset();
+		std::vector<std::string> policies;
+		for (size_t i = 0; i < names.size(); ++i) {
+			if (selected[i]) policies.push_back(names[i]);
+		}
+		SharedWorkload shared = share_workload(use_initial ? workload
+			: random_workload(static_cast<size_t>(processes), static_cast<uint32_t>(seed), 3));
+		comparison = std::make_unique<PolicyComparison>(shared, policies, policy_config, sim_config);
+	}
+	if (!comparison || comparison->size() == 0) return;
+
+	// ÿһ
+	int columns = static_cast<int>(comparison->size()) + 1;
+	if (!ImGui::BeginTable("CompareTable", columns, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchSame)) return;
+	ImGui::TableSetupColumn("Metric");
+	for (size_t i = 0; i < comparison->size(); ++i) ImGui::TableSetupColumn(comparison->progress(i).policy.c_str());
+	ImGui::TableHeadersRow();
+
+	auto row = [&](const char* metric, auto&& cell) {
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(metric);
+		for (size_t i = 0; i < comparison->size(); ++i) {
+			ImGui::TableNextColumn();
+			cell(comparison->progress(i));
+		}
+	};
+	row("Progress", [](const ComparisonProgress& p) {
+		float fraction = p.status.total ? static_cast<float>(p.status.finished) / p.status.total : 0.0f;
+		ImGui::ProgressBar(fraction, ImVec2(-1, 0), p.done ? "done" : nullptr);
+	});
+	row("Simulated Time", [](const ComparisonProgress& p) { ImGui::Text("%.1f", p.stats.now); });
+	row("Avg Turnaround", [](const ComparisonProgress& p) { ImGui::Text("%.2f", p.stats.avg_turnaround()); });
+	row("Avg Waiting", [](const ComparisonProgress& p) { ImGui::Text("%.2f", p.stats.avg_waiting()); });
+	row("Avg Response", [](const ComparisonProgress& p) { ImGui::Text("%.2f", p.stats.avg_response()); });
+	row("p99 Response", [](const ComparisonProgress& p) { ImGui::Text("%.2f", p.latency.response.percentile(99)); });
+	row("Throughput", [](const ComparisonProgress& p) { ImGui::Text("%.4f", p.stats.throughput()); });
+	row("Fairness", [](const ComparisonProgress& p) { ImGui::Text("%.3f", p.stats.fairness()); });
+	row("Context Switches", [](const ComparisonProgress& p) { ImGui::Text("%zu", p.stats.context_switches); });
+	row("Wall Time", [](const ComparisonProgress& p) { ImGui::Text("%.2f s", p.wall_seconds); });
+	ImGui::EndTable();
 }
 
-void priority_scheduling_step(std::vector<PCB>& process_list) {
-	for (auto& process : process_list) {
-		if (process.state == State::R) {
-			process.run_process();
-			break; // ÿֻһȼĽ
+void render_timeline(const SimSnapshot& snapshot) {
+	if (!ImGui::CollapsingHeader("Timeline", ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+	// أɺõǰѡеĲֻ꣬ʱߣ滻Ḻ̌
+	// ں̨߳ܣǰճˢ
+	struct RandomRun {
+		Timeline timeline;
+		std::vector<PCB> process_list;
+		LatencyHistograms latency;
+	};
+	static std::future<RandomRun> job;
+	static int processes = 1000000;
+	static int seed = 1;
+	ImGui::InputInt("Random Processes", &processes, 1000, 100000);
+	ImGui::InputInt("Seed", &seed);
+	if (processes < 1) processes = 1;
+	if (job.valid()) {
+		if (job.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+			RandomRun result = job.get();
+			timeline = std::move(result.timeline);
+			timeline_processes.swap(result.process_list);
+			timeline_from_ticks = false;
+			latency = std::move(result.latency);
+			has_latency = true;
+		}
+		else {
+			ImGui::Text("Running...");
+		}
+	}
+	else if (ImGui::Button("Run Random Workload")) {
+		job = std::async(std::launch::async, [n = static_cast<size_t>(processes), s = static_cast<uint32_t>(seed),
+			policy = scheduler_names()[current_policy], policies = policy_config, config = sim_config] {
+			RandomRun result;
+			result.process_list = random_workload(n, s, 3);
+			std::unique_ptr<AnySimulator> sim = make_simulator(policy, policies, result.process_list, config);
+			sim->set_timeline(&result.timeline);
+			sim->run();
+			result.latency = sim->latency();
+			return result;
+			});
+	}
+	const Timeline& timeline = timeline_from_ticks ? snapshot.timeline : ::timeline;
+	const std::vector<PCB>& timeline_processes = timeline_from_ticks ? snapshot.process_list : ::timeline_processes;
+
+	static bool cpu_view = false;
+	ImGui::SameLine();
+	ImGui::Checkbox("Single CPU Row", &cpu_view);
+	ImGui::Text("Runs: %zu\tEnd: %.2f", timeline.size(), timeline.end_time());
+
+	// ݱ仯ᣬ֮󽻸û϶
+	static size_t fitted_runs = 0;
+	static double fitted_end = -1;
+	static bool fitted_view = false;
+	ImPlotCond cond = ImPlotCond_Once;
+	if (fitted_runs != timeline.size() || fitted_end != timeline.end_time() || fitted_view != cpu_view) {
+		cond = ImPlotCond_Always;
+		fitted_runs = timeline.size();
+		fitted_end = timeline.end_time();
+		fitted_view = cpu_view;
+	}
+
+	int lanes = cpu_view ? 1 : static_cast<int>(timeline.lanes());
+	if (!ImPlot::BeginPlot("##Gantt", ImVec2(-1, 320))) return;
+	ImPlot::SetupAxes("Time", cpu_view ? "CPU" : "Process", 0, ImPlotAxisFlags_Invert);
+	ImPlot::SetupAxisLimits(ImAxis_X1, 0, std::max(1.0, timeline.end_time()), cond);
+	ImPlot::SetupAxisLimits(ImAxis_Y1, -0.5, std::max(lanes, 1) - 0.5, cond);
+
+	// ʱ pid ̶
+	if (!cpu_view && lanes > 0 && lanes <= 32 && timeline_processes.size() >= static_cast<size_t>(lanes)) {
+		std::vector<std::string> names(lanes);
+		std::vector<const char*> labels(lanes);
+		std::vector<double> ticks(lanes);
+		for (int i = 0; i < lanes; ++i) {
+			names[i] = "P" + std::to_string(timeline_processes[i].pid);
+			labels[i] = names[i].c_str();
+			ticks[i] = i;
+		}
+		ImPlot::SetupAxisTicks(ImAxis_Y1, ticks.data(), lanes, labels.data());
+	}
+
+	auto lane_color = [](int32_t lane) {
+		return ImGui::GetColorU32(ImPlot::GetColormapColor(lane % ImPlot::GetColormapSize()));
+	};
+
+	// ÿÿһΣбػʱл֤ͼԪͼ
+	ImPlotRect limits = ImPlot::GetPlotLimits();
+	ImVec2 size = ImPlot::GetPlotSize();
+	int columns = std::max(1, static_cast<int>(size.x));
+	int row_step = std::max(1, static_cast<int>(std::ceil(limits.Y.Size() / std::max(1.0f, size.y))));
+	int first = std::max(0, static_cast<int>(std::ceil(limits.Y.Min - 0.5)));
+	int last = std::min(lanes - 1, static_cast<int>(std::floor(limits.Y.Max + 0.5)));
+	first -= first % row_step;
+
+	ImDrawList* draw = ImPlot::GetPlotDrawList();
+	ImPlot::PushPlotClipRect();
+	for (int row = first; row <= last; row += row_step) {
+		int32_t lane = cpu_view ? -1 : row;
+		timeline.for_each_visible(lane, limits.X.Min, limits.X.Max, columns, [&](double start, double end) {
+			int64_t run = cpu_view ? timeline.find(-1, start) : -1;
+			ImU32 color = lane_color(cpu_view ? (run >= 0 ? timeline.run(run).lane : 0) : lane);
+			ImVec2 a = ImPlot::PlotToPixels(start, row - 0.4);
+			ImVec2 b = ImPlot::PlotToPixels(end, row + 0.4);
+			if (b.x - a.x < 1) b.x = a.x + 1; // һؿ
+			draw->AddRectFilled(ImVec2(a.x, std::min(a.y, b.y)), ImVec2(b.x, std::max(a.y, b.y)), color);
+		});
+	}
+	// ؿʷʱڶӦʱ̻һ
+	if (timeline_from_ticks && snapshot.scrubbing) {
+		float x = ImPlot::PlotToPixels(snapshot.status.now, 0).x;
+		ImVec2 pos = ImPlot::GetPlotPos();
+		draw->AddLine(ImVec2(x, pos.y), ImVec2(x, pos.y + size.y), IM_COL32(255, 255, 255, 255), 2);
+	}
+	ImPlot::PopPlotClipRect();
+
+	if (ImPlot::IsPlotHovered()) {
+		ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+		int row = static_cast<int>(std::floor(mouse.y + 0.5));
+		int64_t run = row >= 0 && row < lanes ? timeline.find(cpu_view ? -1 : row, mouse.x) : -1;
+		if (run >= 0) {
+			const Timeline::Run& r = timeline.run(run);
+			int32_t pid = static_cast<size_t>(r.lane) < timeline_processes.size() ? timeline_processes[r.lane].pid : r.lane;
+			ImGui::BeginTooltip();
+			ImGui::Text("P%d\t%.2f - %.2f", pid, r.start, r.end);
+			ImGui::EndTooltip();
 		}
 	}
-	std::sort(process_list.begin(), process_list.end(),
-		[](const PCB& a, const PCB& b) { return a.priority > b.priority; });
+	ImPlot::EndPlot();
 }
 
-void render_process_list(const std::vector<PCB>& process_list) {
-	ImGui::Text("process list:");
-	ImGui::Separator();
-	ImGui::Text("PID\tPriority\tCPU Time\tRemaining Time\tState");
-	for (const auto& process : process_list) {
-		ImGui::Text("P%d\t\t%d\t\t%.2f\t\t\t%.2f\t\t\t%s",
-			process.pid, process.priority, process.cpu_time, process.all_time,
-			(process.state == State::R ? "R" : "E"));
+void render_latency() {
+	if (!ImGui::CollapsingHeader("Latency Percentiles")) return;
+	if (!has_latency) {
+		ImGui::Text("Run to End or run a random workload first.");
+		return;
 	}
-	ImGui::Separator();
-}
\ No newline at end of file
+
+	// ÿָһӣ p50/p90/p99/p999
+	const char* metrics[] = { "Turnaround", "Waiting", "Response" };
+	const LatencyHistogram* histograms[] = { &latency.turnaround, &latency.waiting, &latency.response };
+	const int groups = 3;
+	const int items = static_cast<int>(LATENCY_PERCENTILE_COUNT);
+	double values[LATENCY_PERCENTILE_COUNT * groups];
+	for (int i = 0; i < items; ++i) {
+		for (int g = 0; g < groups; ++g) values[i * groups + g] = histograms[g]->percentile(LATENCY_PERCENTILES[i]);
+	}
+
+	ImGui::Text("Processes: %zu\tMax Turnaround: %.2f\tMax Waiting: %.2f\tMax Response: %.2f",
+		latency.turnaround.count(), latency.turnaround.max(), latency.waiting.max(), latency.response.max());
+	if (!ImPlot::BeginPlot("##Latency", ImVec2(-1, 260))) return;
+	static const double positions[] = { 0, 1, 2 };
+	ImPlot::SetupAxes(nullptr, "Time", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+	ImPlot::SetupAxisTicks(ImAxis_X1, positions, groups, metrics);
+	ImPlot::PlotBarGroups(LATENCY_PERCENTILE_NAMES, values, items, groups, 0.67, 0);
+	ImPlot::EndPlot();
+}
@@ -0,0 +1,123 @@
+#include "mlfq.h"
+
+#include "bitops.h"
+
+MlfqScheduler::MlfqScheduler(const MlfqConfig& config) : config(config) {
+	if (this->config.quanta.empty()) this->config.quanta.push_back(1);
+	if (this->config.quanta.size() > 64) this->config.quanta.resize(64);
+}
+
+void MlfqScheduler::reset(std::vector<PCB>& process_list) {
+	this->process_list = &process_list;
+	levels.assign(config.quanta.size(), ProcessList(&process_list));
+	non_empty = 0;
+
+	level.assign(process_list.size(), 0);
+	allotment.assign(process_list.size(), config.quanta[0]);
+	boost_epoch.assign(process_list.size(), 0);
+	current_epoch = 0;
+	next_boost = config.boost_period;
+}
+
+int32_t MlfqScheduler::level_of(int32_t id) {
+	if (boost_epoch[id] != current_epoch) {
+		boost_epoch[id] = current_epoch;
+		level[id] = 0;
+		allotment[id] = config.quanta[0];
+	}
+	return level[id];
+}
+
+void MlfqScheduler::enqueue(int32_t id) {
+	int32_t l = level_of(id);
+	levels[l].push_back(id);
+	non_empty |= uint64_t(1) << l;
+}
+
+// һεȾʱЧһʱƬ
+// ƴӵ 0 ̵ļʱƬͨ boost_epoch ã޹ء
+void MlfqScheduler::boost_if_due(double_t now) {
+	if (config.boost_period <= 0 || now < next_boost) return;
+
+	for (size_t l = 1; l < levels.size(); ++l) levels[0].splice_back(levels[l]);
+	non_empty = levels[0].empty() ? 0 : 1;
+	current_epoch++;
+	while (next_boost <= now) next_boost += config.boost_period;
+}
+
+void MlfqScheduler::on_arrival(int32_t id, double_t now) {
+	boost_if_due(now);
+	if (static_cast<size_t>(id) >= level.size()) {
+		level.resize(id + 1);
+		allotment.resize(id + 1);
+		boost_epoch.resize(id + 1);
+	}
+	boost_epoch[id] = current_epoch;
+	level[id] = 0;
+	allotment[id] = config.quanta[0];
+	enqueue(id);
+}
+
+int32_t MlfqScheduler::pick_next(double_t now) {
+	boost_if_due(now);
+	if (non_empty == 0) return -1;
+
+	int32_t l = find_first_set(non_empty);
+	int32_t id = levels[l].pop_front();
+	if (levels[l].empty()) non_empty &= ~(uint64_t(1) << l);
+	return id;
+}
+
+double_t MlfqScheduler::time_slice(int32_t id, double_t now) {
+	level_of(id);
+	return allotment[id];
+}
+
+void MlfqScheduler::on_run(int32_t id, double_t ran, double_t now) {
+	level_of(id);
+	allotment[id] -= ran;
+}
+
+void MlfqScheduler::on_requeue(int32_t id, double_t now) {
+	boost_if_due(now);
+	int32_t l = level_of(id);
+	if (allotment[id] <= 1e-9) {
+		// 걾ʱƬһ
+		if (l + 1 < static_cast<int32_t>(levels.size())) level[id] = l + 1;
+		allotment[id] = config.quanta[level[id]];
+	}
+	enqueue(id);
+}
+
+// I/O ɵĽ̻صԭļʣʱƬ CPU ήҲܿƵ I/O ص 0 
+void MlfqScheduler::on_wakeup(int32_t id, double_t now) {
+	boost_if_due(now);
+	enqueue(id);
+}
+
+bool MlfqScheduler::should_preempt(int32_t running, int32_t arrived, double_t now) {
+	return level_of(arrived) < level_of(running);
+}
+
+void MlfqScheduler::save(SnapshotWriter& out) const {
+	out.put(levels.size());
+	for (const auto& list : levels) list.save(out);
+	out.put(non_empty);
+	out.put_array(level);
+	out.put_array(allotment);
+	out.put_array(boost_epoch);
+	out.put(current_epoch);
+	out.put(next_boost);
+}
+
+bool MlfqScheduler::load(SnapshotReader& in) {
+	size_t count = 0;
+	if (!in.get(count) || count != levels.size()) return in.fail();
+	for (auto& list : levels) list.load(in);
+	in.get(non_empty);
+	in.get_array(level);
+	in.get_array(allotment);
+	in.get_array(boost_epoch);
+	in.get(current_epoch);
+	return in.get(next_boost);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine.h"
+#include "intrusive_list.h"
+#include "pcb.h"
+
+struct MlfqConfig {
+	std::vector<double_t> quanta = { 2, 4, 8, 16 }; //ÿһʱƬ0 ȼߣ 64 
+	double_t boost_period = 100;                     //ÿðн 0 <= 0 ʾ
+};
+
+// ༶У½̽ 0 걾ʱƬһ
+// ÿһʽǿյļ bitmap λѡһֻһ find-first-set
+class MlfqScheduler final : public Scheduler {
+public:
+	explicit MlfqScheduler(const MlfqConfig& config = MlfqConfig());
+
+	const char* name() const override { return "MLFQ"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override;
+	int32_t pick_next(double_t now) override;
+	double_t time_slice(int32_t id, double_t now) override;
+	void on_run(int32_t id, double_t ran, double_t now) override;
+	void on_requeue(int32_t id, double_t now) override;
+	void on_wakeup(int32_t id, double_t now) override;
+	bool should_preempt(int32_t running, int32_t arrived, double_t now) override;
+
+	void save(SnapshotWriter& out) const override;
+	bool load(SnapshotReader& in) override;  //뱣ʱͬ
+
+	int32_t level_of(int32_t id); //̵ǰڼ
+
+private:
+	void enqueue(int32_t id);
+	void boost_if_due(double_t now);
+
+	MlfqConfig config;
+	std::vector<PCB>* process_list = nullptr;
+	std::vector<ProcessList> levels;
+	uint64_t non_empty = 0;               // i λʾ i ǿ
+
+	std::vector<int32_t> level;           //ڼ
+	std::vector<double_t> allotment;      //ʣʱƬ
+	std::vector<uint32_t> boost_epoch;    //ϢӦִΣʱΪ 0 
+	uint32_t current_epoch = 0;
+	double_t next_boost = 0;
+};
@@ -0,0 +1,294 @@
+#include "multicore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "rr.h"
+
+namespace {
+
+class EpochBarrier {
+public:
+	explicit EpochBarrier(size_t count) : count(count) {}
+
+	void arrive_and_wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		size_t gen = generation;
+		if (++waiting == count) {
+			waiting = 0;
+			generation++;
+			cv.notify_all();
+			return;
+		}
+		cv.wait(lock, [&] { return gen != generation; });
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable cv;
+	size_t count;
+	size_t waiting = 0;
+	size_t generation = 0;
+};
+
+}
+
+// ÿֻһ߳ƽжα
+struct alignas(64) MultiCoreSim::Core {
+	IndexRing queue;       //˵жУֻƽ˵̻߳ epoch ̷֮߳
+	int32_t current = -1;
+	double_t slice_left = 0;
+	double_t penalty_left = 0; //λϺûĻʱ
+	double_t clock = 0;
+	double_t loaded = 0;       //ۼƼؽĳ̵ݱ˶
+	uint32_t seed = 1;      //ѡȡ״̬
+	std::vector<int32_t> arrivals; // epoch ֵˡʱźõĽ
+	size_t next_arrival = 0;
+
+	CoreStats stats;
+	size_t finished = 0;
+	double_t total_turnaround = 0;
+	double_t total_waiting = 0;
+	double_t last_finish = 0;
+};
+
+double_t MultiCoreStats::load_imbalance() const {
+	if (cores.empty()) return 0;
+
+	double_t max_busy = 0, sum_busy = 0;
+	for (const auto& core : cores) {
+		max_busy = std::max(max_busy, core.busy_time);
+		sum_busy += core.busy_time;
+	}
+	double_t mean = sum_busy / cores.size();
+	return mean > 0 ? max_busy / mean - 1 : 0;
+}
+
+MultiCoreSim::MultiCoreSim(std::vector<PCB>& process_list, const MultiCoreConfig& config) :
+	process_list(process_list), config(config) {
+	if (this->config.cores < 1) this->config.cores = 1;
+	if (this->config.epoch <= 0) this->config.epoch = this->config.quantum;
+	for (int32_t i = 0; i < this->config.cores; ++i) {
+		cores.emplace_back(new Core());
+		cores.back()->seed = 2654435761u * (i + 1);
+	}
+}
+
+MultiCoreSim::~MultiCoreSim() {}
+
+bool MultiCoreSim::steal_work(size_t thief, int32_t& id) {
+	Core& self = *cores[thief];
+	size_t n = cores.size();
+	if (n < 2) return false;
+
+	// ȡˣӶнϳǸȡ
+	for (int attempt = 0; attempt < 4; ++attempt) {
+		self.seed ^= self.seed << 13;
+		self.seed ^= self.seed >> 17;
+		self.seed ^= self.seed << 5;
+		size_t a = self.seed % n, b = (self.seed / n) % n;
+		size_t victim = cores[a]->queue.size() >= cores[b]->queue.size() ? a : b;
+		if (victim == thief) continue;
+		if (config.placement == Placement::Affinity &&
+			cores[victim]->queue.size() < static_cast<size_t>(std::max(config.steal_threshold, 1))) continue;
+		if (!cores[victim]->queue.empty()) {
+			id = cores[victim]->queue.pop_front();
+			self.stats.steals++;
+			return true;
+		}
+	}
+	return false;
+}
+
+// ÿ˵Ļ水Ƚȳƣϴ֮󱾺ּ˶٣ݾͱ١
+// ĺʱȫġص뱾˵ loaded漴ȡ
+double_t MultiCoreSim::warm_up(size_t index, int32_t id) {
+	if (config.cache_size <= 0) return 0;
+
+	Core& core = *cores[index];
+	PCB& process = process_list[id];
+	double_t footprint = process.footprint > 0 ? process.footprint : config.footprint;
+	bool migrated = process.last_core >= 0 && process.last_core != static_cast<int32_t>(index);
+	double_t resident = 0;
+	if (process.last_core == static_cast<int32_t>(index)) {
+		resident = std::max(0.0, std::min(footprint, config.cache_size) - (core.loaded - cache_mark[id]));
+	}
+	double_t cold = footprint - resident;
+	core.loaded += cold;
+	cache_mark[id] = core.loaded;
+
+	double_t penalty = cold * config.refill_cost;
+	core.stats.warmup_time += penalty;
+	if (migrated) core.stats.migration_penalty += penalty;
+	return penalty;
+}
+
+void MultiCoreSim::run_core(size_t index, double_t epoch_end) {
+	Core& core = *cores[index];
+
+	// ֵ˵ĽڵʱӣͬһʱתĽǰ
+	auto admit = [&] {
+		while (core.next_arrival < core.arrivals.size() && process_list[core.arrivals[core.next_arrival]].arrival <= core.clock) {
+			core.queue.push_back(core.arrivals[core.next_arrival++]);
+		}
+	};
+
+	while (true) {
+		admit();
+		if (core.clock >= epoch_end) break;
+
+		if (core.current < 0) {
+			if (core.queue.empty()) {
+				if (core.next_arrival == core.arrivals.size()) break;
+				core.clock = process_list[core.arrivals[core.next_arrival]].arrival; // еһ̵
+				continue;
+			}
+
+			int32_t id = core.queue.pop_front(); // ˶а FIFO ȡ
+			PCB& process = process_list[id];
+			if (process.first_run < 0) process.first_run = core.clock;
+			if (process.last_core >= 0 && process.last_core != static_cast<int32_t>(index)) core.stats.migrations++;
+			core.penalty_left = warm_up(index, id);
+			process.last_core = static_cast<int32_t>(index);
+			core.stats.dispatches++;
+			core.current = id;
+			core.slice_left = config.quantum;
+		}
+
+		// Ȱѻ̲꣬ſʼƽ
+		if (core.penalty_left > 0) {
+			double_t spent = std::min(core.penalty_left, epoch_end - core.clock);
+			core.penalty_left -= spent;
+			core.clock += spent;
+			continue;
+		}
+
+		PCB& process = process_list[core.current];
+		double_t ran = std::min({ core.slice_left, process.all_time, epoch_end - core.clock });
+		process.run_process(ran);
+		core.stats.busy_time += ran;
+		core.clock += ran;
+		core.slice_left -= ran;
+
+		if (process.state == State::E) {
+			process.finish_time = core.clock;
+			core.finished++;
+			core.total_turnaround += process.finish_time - process.arrival;
+			core.total_waiting += process.finish_time - process.arrival - process.burst;
+			core.last_finish = std::max(core.last_finish, core.clock);
+			core.current = -1;
+		}
+		else if (core.slice_left <= 0) {
+			admit();
+			core.queue.push_back(core.current);
+			core.current = -1;
+		}
+	}
+
+	core.clock = epoch_end;
+	core.arrivals.clear();
+	core.next_arrival = 0;
+}
+
+void MultiCoreSim::run() {
+	std::vector<int32_t> arrival_order;
+	for (size_t i = 0; i < process_list.size(); ++i) {
+		if (process_list[i].state == State::R && process_list[i].all_time > 0) arrival_order.push_back(static_cast<int32_t>(i));
+	}
+	std::stable_sort(arrival_order.begin(), arrival_order.end(), [this](int32_t a, int32_t b) {
+		return process_list[a].arrival < process_list[b].arrival;
+		});
+
+	cache_mark.assign(process_list.size(), 0);
+
+	size_t n_cores = cores.size();
+	size_t n_threads = config.threads > 0 ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+	n_threads = std::min(n_threads, n_cores);
+
+	EpochBarrier barrier(n_threads);
+	double_t epoch_end = 0;
+	bool stop = false;
+
+	auto run_group = [&](size_t worker) {
+		size_t first = worker * n_cores / n_threads;
+		size_t last = (worker + 1) * n_cores / n_threads;
+		for (size_t i = first; i < last; ++i) run_core(i, epoch_end);
+	};
+
+	std::vector<std::thread> workers;
+	for (size_t w = 1; w < n_threads; ++w) {
+		workers.emplace_back([&, w] {
+			while (true) {
+				barrier.arrive_and_wait();
+				if (stop) break;
+				run_group(w);
+				barrier.arrive_and_wait();
+			}
+			});
+	}
+
+	// ߳ epoch ֮䴮еȡַĽ̲жϽͬʱ䵱 0 Ź̡߳
+	// ʱ˵ʱӶͣ epoch_startĽ̶֮ǰӵģȡýʱص
+	size_t next_arrival = 0, finished = 0;
+	double_t epoch_start = 0;
+	while (true) {
+		for (size_t i = 0; i < n_cores; ++i) {
+			int32_t id;
+			if (cores[i]->current < 0 && cores[i]->queue.size() == 0 && steal_work(i, id)) cores[i]->queue.push_back(id);
+		}
+
+		epoch_end = epoch_start + config.epoch;
+		while (next_arrival < arrival_order.size() && process_list[arrival_order[next_arrival]].arrival <= epoch_end) {
+			// ĺˣʱԼ
+			auto load = [&](size_t i) { return cores[i]->queue.size() + cores[i]->arrivals.size() + (cores[i]->current >= 0); };
+			size_t target = 0;
+			for (size_t i = 1; i < n_cores; ++i) {
+				if (load(i) < load(target)) target = i;
+			}
+			cores[target]->arrivals.push_back(arrival_order[next_arrival++]);
+		}
+		if (finished == arrival_order.size()) break;
+
+		barrier.arrive_and_wait();
+		run_group(0);
+		barrier.arrive_and_wait();
+
+		finished = 0;
+		bool idle = true;
+		for (auto& core : cores) {
+			finished += core->finished;
+			if (core->current >= 0 || core->queue.size() > 0) idle = false;
+		}
+		epoch_start = epoch_end;
+
+		// к˶ʱֱһڵ epoch
+		if (idle && next_arrival < arrival_order.size()) {
+			double_t arrival = process_list[arrival_order[next_arrival]].arrival;
+			double_t skip_to = std::floor(arrival / config.epoch) * config.epoch;
+			if (skip_to > epoch_start) {
+				for (auto& core : cores) core->clock = skip_to;
+				epoch_start = skip_to;
+			}
+		}
+	}
+
+	stop = true;
+	barrier.arrive_and_wait();
+	for (auto& worker : workers) worker.join();
+
+	sim_stats = MultiCoreStats();
+	for (auto& core : cores) {
+		sim_stats.cores.push_back(core->stats);
+		sim_stats.now = std::max(sim_stats.now, core->last_finish);
+		sim_stats.finished += core->finished;
+		sim_stats.migrations += core->stats.migrations;
+		sim_stats.steals += core->stats.steals;
+		sim_stats.warmup_time += core->stats.warmup_time;
+		sim_stats.migration_penalty += core->stats.migration_penalty;
+		sim_stats.total_turnaround += core->total_turnaround;
+		sim_stats.total_waiting += core->total_waiting;
+	}
+}
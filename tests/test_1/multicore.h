@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "pcb.h"
+
+struct CoreStats {
+	double_t busy_time = 0;
+	size_t dispatches = 0;
+	size_t migrations = 0;  //ϵĽϴڱĺ
+	size_t steals = 0;      //˵жȡĴ
+	double_t warmup_time = 0;       //Ͻ̺¼ػʱ䣬ڼ䲻ƽ̣ busy_time
+	double_t migration_penalty = 0; //warmup_time зǨ֮Ĳ
+};
+
+// еĺ˴ӱĺȡ̵Ĳ
+enum class Placement : int {
+	Naive = 1,    //ֻҪĺŶӾȡֻؾ
+	Affinity = 2  //ĺŶӴﵽ steal_threshold ȡʱýڻܻȵĺ
+};
+
+struct MultiCoreConfig {
+	int32_t cores = 4;
+	int32_t threads = 0;    //߳0 ʾӲ߳ÿ̸߳һĺ
+	double_t quantum = 4;   //ÿϵתʱƬ
+	double_t epoch = 4;     //ͬʱȣ֮ȡֻ epoch ߽ϽУ;еĺ˵ȵ߽
+
+	Placement placement = Placement::Naive;
+	int32_t steal_threshold = 3;  //Affinity ʱܺҪôŶӽ
+	double_t cache_size = 0;      //ÿ˵Ļ0 ʾģ⻺
+	double_t refill_cost = 0.001; //ÿλռôȵļʱ
+	double_t footprint = 0;       //PCB::footprint Ϊ 0 Ľ̰ռü
+};
+
+struct MultiCoreStats {
+	double_t now = 0;       //һ̽ʱ
+	size_t finished = 0;
+	size_t migrations = 0;
+	size_t steals = 0;
+	double_t total_turnaround = 0;
+	double_t total_waiting = 0;
+	double_t warmup_time = 0;
+	double_t migration_penalty = 0;
+	std::vector<CoreStats> cores;
+
+	double_t utilization(size_t core) const { return now > 0 ? cores[core].busy_time / now : 0; }
+	double_t avg_turnaround() const { return finished ? total_turnaround / finished : 0; }
+	double_t avg_waiting() const { return finished ? total_waiting / finished : 0; }
+	double_t throughput() const { return now > 0 ? finished / now : 0; } //Чѿ۳صʱ
+	double_t load_imbalance() const; //æĺƽæµʱı
+};
+
+// ˵ģ⣺ÿһ FIFO жУ˰ FIFO תеĺ˴˶ȡ
+//  epoch ڶƽֻԼĶкͽ̣Ľ epoch ʼʱָĺˣʱ̲ӣ
+// ȡ epoch ̰֮߳˵˳С˽߳޹أ
+// ͬһʱÿֻһ̷߳ʣҪṹ
+class MultiCoreSim {
+public:
+	MultiCoreSim(std::vector<PCB>& process_list, const MultiCoreConfig& config);
+	~MultiCoreSim();
+
+	void run();
+	const MultiCoreStats& stats() const { return sim_stats; }
+
+private:
+	struct Core;
+
+	void run_core(size_t index, double_t epoch_end);
+	bool steal_work(size_t thief, int32_t& id);
+	double_t warm_up(size_t index, int32_t id); //Ͻʱģͼʱ
+
+	std::vector<PCB>& process_list;
+	MultiCoreConfig config;
+	std::vector<std::unique_ptr<Core>> cores;
+	std::vector<double_t> cache_mark; //ϴкں˵ loaded ֵ֮ص
+	MultiCoreStats sim_stats;
+};
@@ -0,0 +1,29 @@
+#include "pcb.h"
+
+PCB::PCB(int32_t pid, int32_t priority, double_t all_time, double_t cpu_time, State state, double_t arrival) :
+	pid(pid), priority(priority), all_time(all_time), cpu_time(cpu_time), state(state),
+	arrival(arrival), burst(all_time + cpu_time) {}
+
+bool PCB::run_process() {
+	if (state == State::E || all_time == 0) return false;
+
+	priority--;
+	all_time--;
+	cpu_time++;
+
+	if (all_time == 0) state = State::E;
+
+	return true;
+}
+
+bool PCB::run_process(double_t time) {
+	if (state == State::E || all_time == 0) return false;
+
+	if (time > all_time - 1e-9) time = all_time; // Ϊ
+	all_time -= time;
+	cpu_time += time;
+
+	if (all_time == 0) state = State::E;
+
+	return true;
+}
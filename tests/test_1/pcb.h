@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+enum class State : int {
+	R = 1,  //
+	E = 2,  //
+	B = 3   //豸Ŷӻȴ I/O 
+};
+
+class PCB {
+public:
+	PCB(int32_t pid, int32_t priority, double_t all_time, double_t cpu_time, State state, double_t arrival = 0);
+
+	bool run_process();              //һʱ䵥λȼһ
+	bool run_process(double_t time); // timeıȼ
+
+	int32_t pid = 0;        //̱ʶ
+	int32_t priority = 0;   //ȼ
+	double_t all_time = 0;  //̳лҪеʱ
+	double_t cpu_time = 0;  //ռõCPUʱ
+	State state = State::R; //״̬ĬΪ
+
+	double_t arrival = 0;      //ʱ
+	double_t burst = 0;        //ܷʱ
+	double_t first_run = -1;   //״ʱ̣-1 ʾδ
+	double_t finish_time = -1; //ʱ
+	int32_t last_core = -1;    //ϴڵĺˣģ⣩
+	double_t footprint = 0;    //ģĻռãģ⣩ڱĺл򱻼Ҫ¼
+	double_t vruntime = 0;     //Ȩʱ䣨CFS
+	double_t deadline = -1;    //Խֹʱ䣬< 0 ʾûУʵʱҵ
+
+	double_t io_every = 0;     //ÿж÷һ I/O0 ʾ CPU 
+	double_t io_time = 0;      //ÿ I/O ƽʱ䣬ʵʷʱ䰴豸ķֲȡ
+	int32_t device = 0;        //I/O 豸
+	double_t until_io = 0;     //һ I/O Ҫж
+	double_t blocked_at = -1;  //һʱ
+	double_t io_wait = 0;      //ۼʱ䣨豸ŶӼӷ񣩣ȴ CPU
+
+	int32_t prev = -1;         //ʽָ루±꣩ͬһʱֻһл豸У
+	int32_t next = -1;
+};
+
+// ̼״̬仯άжǷȫֻ O(1)
+struct ProcessStatus {
+	size_t total = 0;
+	size_t runnable = 0; //ѵδ
+	size_t finished = 0;
+	double_t now = 0;    //ǰģʱ
+
+	bool done() const { return finished == total; }
+};
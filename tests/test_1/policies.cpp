@@ -0,0 +1,100 @@
+#include "policies.h"
+
+#include "engine_impl.h"
+
+template class BasicSimulator<PriorityScheduler>;
+template class BasicSimulator<RoundRobinScheduler>;
+template class BasicSimulator<StrideScheduler>;
+template class BasicSimulator<LotteryScheduler>;
+template class BasicSimulator<EdfScheduler>;
+template class BasicSimulator<RmsScheduler>;
+template class BasicSimulator<MlfqScheduler>;
+template class BasicSimulator<CfsScheduler>;
+template class BasicSimulator<SjfScheduler>;
+
+namespace {
+
+SjfConfig sjf_config(const PolicyConfig& config, bool preemptive) {
+	SjfConfig sjf = config.sjf;
+	sjf.preemptive = preemptive;
+	return sjf;
+}
+
+// Զ֮ǰ죬湹ʱõ reset ܿĲ
+template <typename Policy>
+class PolicySimulator final : public AnySimulator {
+public:
+	PolicySimulator(Policy policy, std::vector<PCB>& process_list, const SimConfig& config, WorkloadSource* source) :
+		policy(std::move(policy)),
+		sim(source ? BasicSimulator<Policy>(process_list, this->policy, *source, config) : BasicSimulator<Policy>(process_list, this->policy, config)) {}
+
+	const char* name() const override { return policy.name(); }
+	bool step() override { return sim.step(); }
+	void run() override { sim.run(); }
+	void run_until(double_t time) override { sim.run_until(time); }
+	void run_before(double_t time) override { sim.run_before(time); }
+
+	bool finished() const override { return sim.finished(); }
+	double_t now() const override { return sim.now(); }
+	const SimStats& stats() const override { return sim.stats(); }
+	const LatencyHistograms& latency() const override { return sim.latency(); }
+	ProcessStatus status() const override { return sim.status(); }
+	void set_timeline(Timeline* timeline) override { sim.set_timeline(timeline); }
+	void set_recorder(SimRecorder* recorder) override { sim.set_recorder(recorder); }
+
+	void save(SnapshotWriter& out) const override { sim.save(out); }
+	bool load(SnapshotReader& in) override { return sim.load(in); }
+	bool load_delta(SnapshotReader& in, bool processes_only) override { return sim.load_delta(in, processes_only); }
+
+private:
+	Policy policy;
+	BasicSimulator<Policy> sim;
+};
+
+template <typename Policy>
+std::unique_ptr<AnySimulator> wrap(Policy policy, std::vector<PCB>& process_list, const SimConfig& config, WorkloadSource* source) {
+	return std::unique_ptr<AnySimulator>(new PolicySimulator<Policy>(std::move(policy), process_list, config, source));
+}
+
+}
+
+std::unique_ptr<Scheduler> make_scheduler(const std::string& name, const PolicyConfig& config) {
+	if (name == "priority") return std::unique_ptr<Scheduler>(new PriorityScheduler());
+	if (name == "rr") return std::unique_ptr<Scheduler>(new RoundRobinScheduler(config.rr));
+	if (name == "stride") return std::unique_ptr<Scheduler>(new StrideScheduler(config.proportional));
+	if (name == "lottery") return std::unique_ptr<Scheduler>(new LotteryScheduler(config.proportional));
+	if (name == "edf") return std::unique_ptr<Scheduler>(new EdfScheduler());
+	if (name == "rms") return std::unique_ptr<Scheduler>(new RmsScheduler());
+	if (name == "mlfq") return std::unique_ptr<Scheduler>(new MlfqScheduler(config.mlfq));
+	if (name == "cfs") return std::unique_ptr<Scheduler>(new CfsScheduler(config.cfs));
+	if (name == "sjf") return std::unique_ptr<Scheduler>(new SjfScheduler(sjf_config(config, false)));
+	if (name == "srtf") return std::unique_ptr<Scheduler>(new SjfScheduler(sjf_config(config, true)));
+	return nullptr;
+}
+
+std::unique_ptr<AnySimulator> make_simulator(const std::string& name, const PolicyConfig& config,
+	std::vector<PCB>& process_list, const SimConfig& sim_config, WorkloadSource* source) {
+	if (name == "priority") return wrap(PriorityScheduler(), process_list, sim_config, source);
+	if (name == "rr") return wrap(RoundRobinScheduler(config.rr), process_list, sim_config, source);
+	if (name == "stride") return wrap(StrideScheduler(config.proportional), process_list, sim_config, source);
+	if (name == "lottery") return wrap(LotteryScheduler(config.proportional), process_list, sim_config, source);
+	if (name == "edf") return wrap(EdfScheduler(), process_list, sim_config, source);
+	if (name == "rms") return wrap(RmsScheduler(), process_list, sim_config, source);
+	if (name == "mlfq") return wrap(MlfqScheduler(config.mlfq), process_list, sim_config, source);
+	if (name == "cfs") return wrap(CfsScheduler(config.cfs), process_list, sim_config, source);
+	if (name == "sjf") return wrap(SjfScheduler(sjf_config(config, false)), process_list, sim_config, source);
+	if (name == "srtf") return wrap(SjfScheduler(sjf_config(config, true)), process_list, sim_config, source);
+	return nullptr;
+}
+
+const std::vector<std::string>& scheduler_names() {
+	static const std::vector<std::string> names = { "priority", "rr", "stride", "lottery", "edf", "rms", "mlfq", "cfs", "sjf", "srtf" };
+	return names;
+}
+
+void set_quantum(PolicyConfig& config, double_t quantum) {
+	config.rr.quantum = quantum;
+	config.proportional.quantum = quantum;
+	for (size_t i = 0; i < config.mlfq.quanta.size(); ++i) config.mlfq.quanta[i] = quantum * (1 << i);
+	config.cfs.min_granularity = quantum;
+}
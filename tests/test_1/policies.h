@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cfs.h"
+#include "engine.h"
+#include "mlfq.h"
+#include "proportional.h"
+#include "realtime.h"
+#include "rr.h"
+#include "scheduling.h"
+#include "sjf.h"
+
+struct PolicyConfig {
+	MlfqConfig mlfq;
+	CfsConfig cfs;
+	RrConfig rr;
+	ProportionalConfig proportional; //stride  lottery 
+	SjfConfig sjf;                   //sjf  srtf ãǷռ־
+};
+
+// ִȲԣ޽йãֲʶʱؿָ
+std::unique_ptr<Scheduler> make_scheduler(const std::string& name, const PolicyConfig& config = PolicyConfig());
+const std::vector<std::string>& scheduler_names();
+
+// Ե policies.cpp ʵ
+extern template class BasicSimulator<PriorityScheduler>;
+extern template class BasicSimulator<RoundRobinScheduler>;
+extern template class BasicSimulator<StrideScheduler>;
+extern template class BasicSimulator<LotteryScheduler>;
+extern template class BasicSimulator<EdfScheduler>;
+extern template class BasicSimulator<RmsScheduler>;
+extern template class BasicSimulator<MlfqScheduler>;
+extern template class BasicSimulator<CfsScheduler>;
+extern template class BasicSimulator<SjfScheduler>;
+
+// ѡԵģÿֲԸʵһ BasicSimulator¼ѭûã
+// һ麯ֻ step/run ϵһΡԶԼС
+class AnySimulator {
+public:
+	virtual ~AnySimulator() {}
+
+	virtual const char* name() const = 0;
+	virtual bool step() = 0;
+	virtual void run() = 0;
+	virtual void run_until(double_t time) = 0;
+	virtual void run_before(double_t time) = 0;
+
+	virtual bool finished() const = 0;
+	virtual double_t now() const = 0;
+	virtual const SimStats& stats() const = 0;
+	virtual const LatencyHistograms& latency() const = 0;
+	virtual ProcessStatus status() const = 0;
+	virtual void set_timeline(Timeline* timeline) = 0;
+	virtual void set_recorder(SimRecorder* recorder) = 0;
+
+	virtual void save(SnapshotWriter& out) const = 0;
+	virtual bool load(SnapshotReader& in) = 0;
+	virtual bool load_delta(SnapshotReader& in, bool processes_only) = 0;
+};
+
+//  make_scheduler ֲͬʶʱؿָ롣source ǿʱΪʽء
+std::unique_ptr<AnySimulator> make_simulator(const std::string& name, const PolicyConfig& config,
+	std::vector<PCB>& process_list, const SimConfig& sim_config = SimConfig(), WorkloadSource* source = nullptr);
+
+// һʱƬ׵ϣRRstridelottery ʱƬMLFQ  0 ʱƬ𼶷CFS С
+void set_quantum(PolicyConfig& config, double_t quantum);
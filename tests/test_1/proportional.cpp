@@ -0,0 +1,133 @@
+#include "proportional.h"
+
+#include <algorithm>
+
+int64_t tickets_of(const PCB& process) {
+	return std::max<int64_t>(1, process.priority);
+}
+
+void StrideScheduler::reset(std::vector<PCB>& process_list) {
+	this->process_list = &process_list;
+	stride.assign(process_list.size(), 0);
+	pass.assign(process_list.size(), 0);
+	ready = IndexedHeap<PassOrder>(PassOrder{ &pass });
+	ready.reserve(process_list.size());
+	global_pass = 0;
+}
+
+void StrideScheduler::on_arrival(int32_t id, double_t now) {
+	if (static_cast<size_t>(id) >= pass.size()) {
+		stride.resize(id + 1);
+		pass.resize(id + 1);
+	}
+	stride[id] = STRIDE1 / tickets_of((*process_list)[id]);
+	pass[id] = global_pass + stride[id];
+	ready.push(id);
+}
+
+// ڼ pass ʱ׷ global_passµĽһܿ·ݶ
+void StrideScheduler::on_wakeup(int32_t id, double_t now) {
+	pass[id] = std::max(pass[id], global_pass);
+	ready.push(id);
+}
+
+int32_t StrideScheduler::pick_next(double_t now) {
+	if (ready.empty()) return -1;
+
+	int32_t id = ready.pop();
+	global_pass = std::max(global_pass, pass[id]);
+	return id;
+}
+
+void StrideScheduler::on_run(int32_t id, double_t ran, double_t now) {
+	pass[id] += config.quantum > 0 ? stride[id] * ran / config.quantum : stride[id];
+}
+
+void TicketTree::assign(size_t n) {
+	tree.assign(n + 1, 0);
+	value.assign(n, 0);
+	sum = 0;
+}
+
+void TicketTree::add(int32_t id, int64_t delta) {
+	if (static_cast<size_t>(id) >= value.size()) {
+		// ݺؽO(n)̯ÿǰĲ
+		size_t n = std::max<size_t>(id + 1, value.size() * 2);
+		value.resize(n, 0);
+		tree.assign(n + 1, 0);
+		for (size_t i = 1; i <= n; ++i) {
+			tree[i] += value[i - 1];
+			size_t parent = i + (i & (0 - i));
+			if (parent <= n) tree[parent] += tree[i];
+		}
+	}
+
+	value[id] += delta;
+	sum += delta;
+	for (size_t i = id + 1; i < tree.size(); i += i & (0 - i)) tree[i] += delta;
+}
+
+int32_t TicketTree::find(int64_t ticket) const {
+	// Ըλλλȷÿǰ׺Ͳ ticket һ
+	size_t n = tree.size() - 1;
+	size_t step = 1;
+	while (step * 2 <= n) step *= 2;
+
+	size_t i = 0;
+	for (; step > 0; step /= 2) {
+		if (i + step <= n && tree[i + step] <= ticket) {
+			i += step;
+			ticket -= tree[i];
+		}
+	}
+	return static_cast<int32_t>(i); // i + 1 λã± i
+}
+
+void LotteryScheduler::reset(std::vector<PCB>& process_list) {
+	this->process_list = &process_list;
+	tickets.assign(process_list.size());
+	gen.seed(config.seed);
+}
+
+void LotteryScheduler::on_arrival(int32_t id, double_t now) {
+	tickets.add(id, tickets_of((*process_list)[id]));
+}
+
+int32_t LotteryScheduler::pick_next(double_t now) {
+	if (tickets.total() <= 0) return -1;
+
+	int64_t ticket = std::uniform_int_distribution<int64_t>(0, tickets.total() - 1)(gen);
+	int32_t id = tickets.find(ticket);
+	tickets.add(id, -tickets_of((*process_list)[id]));
+	return id;
+}
+
+void StrideScheduler::save(SnapshotWriter& out) const {
+	out.put_array(stride);
+	out.put_array(pass);
+	ready.save(out);
+	out.put(global_pass);
+}
+
+bool StrideScheduler::load(SnapshotReader& in) {
+	return in.get_array(stride) && in.get_array(pass) && ready.load(in) && in.get(global_pass);
+}
+
+void TicketTree::save(SnapshotWriter& out) const {
+	out.put_array(tree);
+	out.put_array(value);
+	out.put(sum);
+}
+
+bool TicketTree::load(SnapshotReader& in) {
+	return in.get_array(tree) && in.get_array(value) && in.get(sum);
+}
+
+void LotteryScheduler::save(SnapshotWriter& out) const {
+	tickets.save(out);
+	out.put_engine(gen);
+}
+
+bool LotteryScheduler::load(SnapshotReader& in) {
+	return tickets.load(in) && in.get_engine(gen);
+}
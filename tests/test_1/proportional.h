@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+#include "ready_queue.h"
+
+struct ProportionalConfig {
+	double_t quantum = 1;  //ÿεеʱƬ<= 0 ʱһֱе
+	uint64_t seed = 1;     //Ʊȵӣͬһӽɸ
+};
+
+// ݶȵƱ̵ʱȼһšĿ CPU ݶ = Ʊ / Ʊ
+int64_t tickets_of(const PCB& process);
+
+// ȣstride = STRIDE1 / ƱÿһʱƬ pass һ strideһƬ
+//  pass СĽ̡pass ڴСѡͷŻض O(log n)
+class StrideScheduler final : public Scheduler {
+public:
+	explicit StrideScheduler(const ProportionalConfig& config = ProportionalConfig()) : config(config) {}
+
+	const char* name() const override { return "Stride"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override;
+	int32_t pick_next(double_t now) override;
+	double_t time_slice(int32_t id, double_t now) override { return config.quantum > 0 ? config.quantum : RUN_TO_END; }
+	void on_run(int32_t id, double_t ran, double_t now) override;
+	void on_requeue(int32_t id, double_t now) override { ready.push(id); }
+	void on_wakeup(int32_t id, double_t now) override;
+
+	void save(SnapshotWriter& out) const override;
+	bool load(SnapshotReader& in) override;
+
+	static constexpr double_t STRIDE1 = 1 << 20;
+
+private:
+	struct PassOrder {
+		const std::vector<double_t>* pass = nullptr;
+
+		bool operator()(int32_t a, int32_t b) const {
+			double_t pa = (*pass)[a], pb = (*pass)[b];
+			return pa < pb || (pa == pb && a < b);
+		}
+	};
+
+	ProportionalConfig config;
+	std::vector<PCB>* process_list = nullptr;
+	std::vector<double_t> stride;
+	std::vector<double_t> pass;
+	IndexedHeap<PassOrder> ready;
+	double_t global_pass = 0; //һѡн̵ pass½̴𲽣ܿ۵Ƿ˰ռ CPU
+};
+
+// ״飨Fenwick treeάÿ±Ʊ֧ O(log n) ĵ޸ĺ͡ k Ʊ˭
+class TicketTree {
+public:
+	void assign(size_t n);
+	void add(int32_t id, int64_t delta);  //±곬ǰʱԶ
+	int32_t find(int64_t ticket) const;   //ǰ׺״γ ticket ±꣬ticket С total()
+	int64_t total() const { return sum; }
+
+	void save(SnapshotWriter& out) const;
+	bool load(SnapshotReader& in);
+
+private:
+	std::vector<int64_t> tree;  //tree[i] Ϊ (i - lowbit(i), i] ĺͣ± 1 ʼ
+	std::vector<int64_t> value; //±굱ǰƱؽʱ
+	int64_t sum = 0;
+};
+
+// ƱȣÿʱƬо̵ƱһţС
+// еĽ̵ƱʱȡŻʱټϡ
+class LotteryScheduler final : public Scheduler {
+public:
+	explicit LotteryScheduler(const ProportionalConfig& config = ProportionalConfig()) : config(config) {}
+
+	const char* name() const override { return "Lottery"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override;
+	int32_t pick_next(double_t now) override;
+	double_t time_slice(int32_t id, double_t now) override { return config.quantum > 0 ? config.quantum : RUN_TO_END; }
+	void on_requeue(int32_t id, double_t now) override { tickets.add(id, tickets_of((*process_list)[id])); }
+
+	void save(SnapshotWriter& out) const override;
+	bool load(SnapshotReader& in) override;
+
+private:
+	ProportionalConfig config;
+	std::vector<PCB>* process_list = nullptr;
+	TicketTree tickets;
+	std::mt19937_64 gen;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../common/snapshot.h"
+#include "pcb.h"
+
+// ĶѣԪǽ process_list е±ꡣ
+// pos ¼ÿ±ڶеλã˹ؼֱ仯 O(log n) ԭصdecrease-key
+// Less(a, b) Ϊ true ʾ a Ӧ b ѡ
+template <typename Less>
+class IndexedHeap {
+public:
+	explicit IndexedHeap(Less less = Less()) : less(less) {}
+
+	bool empty() const { return heap.empty(); }
+	size_t size() const { return heap.size(); }
+	int32_t top() const { return heap.front(); }
+
+	bool contains(int32_t id) const {
+		return id >= 0 && static_cast<size_t>(id) < pos.size() && pos[id] >= 0;
+	}
+
+	void reserve(size_t n) {
+		heap.reserve(n);
+		if (pos.size() < n) pos.resize(n, -1);
+	}
+
+	void clear() {
+		for (int32_t id : heap) pos[id] = -1;
+		heap.clear();
+	}
+
+	void push(int32_t id) {
+		if (static_cast<size_t>(id) >= pos.size()) pos.resize(id + 1, -1);
+		pos[id] = static_cast<int32_t>(heap.size());
+		heap.push_back(id);
+		sift_up(heap.size() - 1);
+	}
+
+	int32_t pop() {
+		int32_t id = heap.front();
+		erase_at(0);
+		return id;
+	}
+
+	// ؼָıã
+	void update(int32_t id) {
+		size_t i = pos[id];
+		sift_up(i);
+		sift_down(pos[id]);
+	}
+
+	void erase(int32_t id) {
+		if (contains(id)) erase_at(pos[id]);
+	}
+
+	//  O(n)ids е±겻ڶ
+	template <typename It>
+	void assign(It first, It last) {
+		clear();
+		for (; first != last; ++first) {
+			int32_t id = *first;
+			if (static_cast<size_t>(id) >= pos.size()) pos.resize(id + 1, -1);
+			pos[id] = static_cast<int32_t>(heap.size());
+			heap.push_back(id);
+		}
+		for (size_t i = heap.size() / 2; i-- > 0; ) sift_down(i);
+	}
+
+	Less& order() { return less; }
+
+	// ȽָɲԵ reset ã
+	void save(SnapshotWriter& out) const {
+		out.put_array(heap);
+		out.put_array(pos);
+	}
+
+	bool load(SnapshotReader& in) {
+		return in.get_array(heap) && in.get_array(pos);
+	}
+
+private:
+	void erase_at(size_t i) {
+		pos[heap[i]] = -1;
+		int32_t last = heap.back();
+		heap.pop_back();
+		if (i == heap.size()) return;
+		heap[i] = last;
+		pos[last] = static_cast<int32_t>(i);
+		sift_up(i);
+		sift_down(pos[last]);
+	}
+
+	void sift_up(size_t i) {
+		int32_t id = heap[i];
+		while (i > 0) {
+			size_t parent = (i - 1) / 2;
+			if (!less(id, heap[parent])) break;
+			heap[i] = heap[parent];
+			pos[heap[i]] = static_cast<int32_t>(i);
+			i = parent;
+		}
+		heap[i] = id;
+		pos[id] = static_cast<int32_t>(i);
+	}
+
+	void sift_down(size_t i) {
+		int32_t id = heap[i];
+		size_t n = heap.size();
+		while (true) {
+			size_t child = 2 * i + 1;
+			if (child >= n) break;
+			if (child + 1 < n && less(heap[child + 1], heap[child])) child++;
+			if (!less(heap[child], id)) break;
+			heap[i] = heap[child];
+			pos[heap[i]] = static_cast<int32_t>(i);
+			i = child;
+		}
+		heap[i] = id;
+		pos[id] = static_cast<int32_t>(i);
+	}
+
+	std::vector<int32_t> heap;
+	std::vector<int32_t> pos; //± -> λã-1 ʾڶ
+	Less less;
+};
+
+// ȼȳȼͬ pid С
+struct PriorityOrder {
+	const std::vector<PCB>* process_list = nullptr;
+
+	bool operator()(int32_t a, int32_t b) const {
+		const PCB& pa = (*process_list)[a];
+		const PCB& pb = (*process_list)[b];
+		if (pa.priority != pb.priority) return pa.priority > pb.priority;
+		return pa.pid < pb.pid;
+	}
+};
+
+using ReadyQueue = IndexedHeap<PriorityOrder>;
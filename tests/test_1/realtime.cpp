@@ -0,0 +1,285 @@
+#include "realtime.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <tuple>
+
+bool load_tasks(const std::string& path, std::vector<PeriodicTask>& tasks) {
+	std::ifstream in(path);
+	if (!in) {
+		std::cerr << "Failed to open task set: " << path << std::endl;
+		return false;
+	}
+
+	tasks.clear();
+	std::string line;
+	size_t line_no = 0;
+	while (std::getline(in, line)) {
+		line_no++;
+		size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#') continue;
+
+		std::istringstream fields(line);
+		PeriodicTask task;
+		if (!(fields >> task.pid >> task.period >> task.wcet) || task.period <= 0 || task.wcet <= 0) {
+			std::cerr << path << ":" << line_no << ": expected \"pid period wcet [deadline [phase]]\"" << std::endl;
+			return false;
+		}
+		fields >> task.deadline >> task.phase;
+		tasks.push_back(task);
+	}
+
+	return true;
+}
+
+double_t hyperperiod(const std::vector<PeriodicTask>& tasks) {
+	const uint64_t limit = uint64_t(1) << 53;
+	uint64_t result = 1;
+	for (const auto& task : tasks) {
+		double_t period = std::round(task.period);
+		if (std::abs(period - task.period) > 1e-9 || period < 1 || period > limit) return 0;
+
+		uint64_t p = static_cast<uint64_t>(period);
+		uint64_t g = std::gcd(result, p);
+		if (result / g > limit / p) return 0;
+		result = result / g * p;
+	}
+	return tasks.empty() ? 0 : static_cast<double_t>(result);
+}
+
+//  RMS ȼӸߵе±
+static std::vector<size_t> rate_monotonic_order(const std::vector<PeriodicTask>& tasks) {
+	std::vector<size_t> order(tasks.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return tasks[a].period < tasks[b].period; });
+	return order;
+}
+
+Schedulability analyze(const std::vector<PeriodicTask>& tasks) {
+	Schedulability result;
+	size_t n = tasks.size();
+	bool implicit = true; // D >= T
+	for (const auto& task : tasks) {
+		result.utilization += task.wcet / task.period;
+		result.density += task.wcet / std::min(task.relative_deadline(), task.period);
+		if (task.relative_deadline() < task.period) implicit = false;
+	}
+	result.liu_layland = n ? n * (std::pow(2.0, 1.0 / n) - 1) : 1;
+	result.rms_liu_layland = implicit && result.utilization <= result.liu_layland + 1e-12;
+	result.edf = implicit ? result.utilization <= 1 + 1e-12 : result.density <= 1 + 1e-12;
+
+	// ӦʱR = C_i + _{j ȼ} ceil(R / T_j) C_j򳬹ֹʱ
+	result.response_times.assign(n, 0);
+	result.rms_response_time = result.utilization <= 1 + 1e-12;
+	std::vector<size_t> order = rate_monotonic_order(tasks);
+	for (size_t k = 0; k < n; ++k) {
+		const PeriodicTask& task = tasks[order[k]];
+		double_t response = task.wcet;
+		while (true) {
+			double_t next = task.wcet;
+			for (size_t j = 0; j < k; ++j) {
+				const PeriodicTask& higher = tasks[order[j]];
+				next += std::ceil(response / higher.period - 1e-9) * higher.wcet;
+			}
+			if (next > task.relative_deadline() + 1e-9) {
+				response = RUN_TO_END;
+				break;
+			}
+			if (next <= response + 1e-9) break;
+			response = next;
+		}
+		result.response_times[order[k]] = response;
+		if (response > task.relative_deadline() + 1e-9) result.rms_response_time = false;
+	}
+
+	return result;
+}
+
+PeriodicSource::PeriodicSource(const std::vector<PeriodicTask>& tasks, double_t horizon) :
+	tasks(tasks), rm_priority(tasks.size()), released(tasks.size(), 0), horizon(horizon) {
+	std::vector<size_t> order = rate_monotonic_order(tasks);
+	for (size_t k = 0; k < order.size(); ++k) rm_priority[order[k]] = static_cast<int32_t>(order.size() - k);
+
+	for (size_t i = 0; i < tasks.size(); ++i) {
+		if (tasks[i].phase >= horizon) continue;
+		total += static_cast<size_t>(std::ceil((horizon - tasks[i].phase) / tasks[i].period));
+		upcoming.emplace(tasks[i].phase, i);
+	}
+}
+
+bool PeriodicSource::next(PCB& process) {
+	if (upcoming.empty()) return false;
+
+	double_t release = upcoming.top().first;
+	size_t i = upcoming.top().second;
+	upcoming.pop();
+
+	const PeriodicTask& task = tasks[i];
+	process = PCB(task.pid, rm_priority[i], task.wcet, 0, State::R, release);
+	process.deadline = release + task.relative_deadline();
+
+	double_t next_release = task.phase + ++released[i] * task.period;
+	if (next_release < horizon) upcoming.emplace(next_release, i);
+	return true;
+}
+
+void EdfScheduler::reset(std::vector<PCB>& process_list) {
+	ready = IndexedHeap<DeadlineOrder>(DeadlineOrder{ &process_list });
+	ready.reserve(process_list.size());
+}
+
+void RmsScheduler::reset(std::vector<PCB>& process_list) {
+	ready = IndexedHeap<FixedPriorityOrder>(FixedPriorityOrder{ &process_list });
+	ready.reserve(process_list.size());
+}
+
+// ߽ʱϵͳδҵ״̬ʱ䶼Ա߽ƫơ߽״̬ͬ
+// ͷģʽԳΪڣȷԵĵ֮ͻȫظһڡ
+// лʱеҵǷлСʱƬʣ١ϴεȵĸҵٵƿ
+// ҲӰ֮ĵȣһȽϡ
+struct BoundaryState {
+	std::vector<std::tuple<int32_t, double_t, double_t, double_t, bool, bool>> jobs; //pidֹʣࡢСϴε
+	double_t switch_left = 0; //ҵʣлʱ
+	double_t slice_left = 0;
+};
+
+static BoundaryState boundary_state(const std::vector<PCB>& slots, const Simulator& sim, double_t boundary) {
+	BoundaryState state;
+	for (size_t i = 0; i < slots.size(); ++i) {
+		const PCB& job = slots[i];
+		// ǡڱ߽ҵǽ̬¼ûδ
+		if (job.finish_time >= 0 || job.arrival >= boundary) continue;
+		// ϴεȵҵѽ֮κҵлûϴεȵȼۣؼ¼
+		state.jobs.emplace_back(job.pid, job.arrival - boundary, job.deadline - boundary, job.all_time,
+			static_cast<int32_t>(i) == sim.running(), static_cast<int32_t>(i) == sim.last_running());
+	}
+	std::sort(state.jobs.begin(), state.jobs.end());
+	if (sim.running() >= 0) {
+		state.switch_left = std::max(0.0, sim.running_since() - boundary);
+		state.slice_left = sim.slice_left();
+	}
+	return state;
+}
+
+static bool same_state(const BoundaryState& a, const BoundaryState& b) {
+	if (a.jobs.size() != b.jobs.size()) return false;
+	if (std::abs(a.switch_left - b.switch_left) > 1e-6 || std::abs(a.slice_left - b.slice_left) > 1e-6) return false;
+	for (size_t i = 0; i < a.jobs.size(); ++i) {
+		const auto& x = a.jobs[i];
+		const auto& y = b.jobs[i];
+		if (std::get<0>(x) != std::get<0>(y) || std::get<4>(x) != std::get<4>(y) || std::get<5>(x) != std::get<5>(y)) return false;
+		if (std::abs(std::get<1>(x) - std::get<1>(y)) > 1e-6) return false;
+		if (std::abs(std::get<2>(x) - std::get<2>(y)) > 1e-6) return false;
+		if (std::abs(std::get<3>(x) - std::get<3>(y)) > 1e-6) return false;
+	}
+	return true;
+}
+
+// into += times * (to - from)ۼӵֶΰֵƣֵֶȡ߽ϴ
+static void add_scaled(SimStats& into, const SimStats& to, const SimStats& from, double_t times) {
+	auto count = [times](size_t a, size_t b) { return static_cast<size_t>(std::llround(times * (static_cast<double_t>(a) - b))); };
+
+	into.now += times * (to.now - from.now);
+	into.busy_time += times * (to.busy_time - from.busy_time);
+	into.events += count(to.events, from.events);
+	into.dispatches += count(to.dispatches, from.dispatches);
+	into.context_switches += count(to.context_switches, from.context_switches);
+	into.switch_time += times * (to.switch_time - from.switch_time);
+	into.finished += count(to.finished, from.finished);
+	into.total_turnaround += times * (to.total_turnaround - from.total_turnaround);
+	into.total_waiting += times * (to.total_waiting - from.total_waiting);
+	into.total_response += times * (to.total_response - from.total_response);
+	into.total_slowdown += times * (to.total_slowdown - from.total_slowdown);
+	into.total_slowdown_sq += times * (to.total_slowdown_sq - from.total_slowdown_sq);
+	into.deadline_jobs += count(to.deadline_jobs, from.deadline_jobs);
+	into.deadline_misses += count(to.deadline_misses, from.deadline_misses);
+	into.total_tardiness += times * (to.total_tardiness - from.total_tardiness);
+	into.max_lateness = std::max(into.max_lateness, to.max_lateness);
+	for (size_t i = 0; i < LATENESS_BUCKETS; ++i) into.lateness_buckets[i] += count(to.lateness_buckets[i], from.lateness_buckets[i]);
+	into.io_requests += count(to.io_requests, from.io_requests);
+	into.io_busy_time += times * (to.io_busy_time - from.io_busy_time);
+	into.blocked_time += times * (to.blocked_time - from.blocked_time);
+}
+
+static size_t pending_jobs(const std::vector<PCB>& slots, double_t horizon) {
+	size_t pending = 0;
+	for (const auto& job : slots) {
+		if (job.finish_time < 0 && job.arrival < horizon) pending++;
+	}
+	return pending;
+}
+
+RealTimeResult run_realtime(const std::vector<PeriodicTask>& tasks, Scheduler& scheduler, const RealTimeConfig& config) {
+	RealTimeResult result;
+	result.hyperperiod = hyperperiod(tasks);
+
+	double_t start = 0, longest = 0;
+	for (const auto& task : tasks) {
+		start = std::max(start, task.phase);
+		longest = std::max(longest, task.period);
+	}
+	double_t horizon = config.horizon;
+	if (horizon <= 0) horizon = start + (result.hyperperiod > 0 ? result.hyperperiod : 100 * longest);
+
+	std::vector<PCB> slots;
+	PeriodicSource source(tasks, horizon);
+	Simulator sim(slots, scheduler, source, config.sim);
+
+	// ѿʼͷźÿڵͷģʽͬ start 𰴳з
+	double_t window = result.hyperperiod;
+	size_t windows = window > 0 && horizon > start ? static_cast<size_t>(std::floor((horizon - start) / window)) : 0;
+	if (!config.skip_repeats) windows = 0;
+
+	// ȱȽ O(1) δҵеҵͬʱɨ衢вλ״̬
+	// ʱѹ״̬ظδҵ;ûм١ۼ GIVE_UP_GROWTH κͲٳ
+	auto running_pid = [&] { return sim.running() >= 0 ? slots[sim.running()].pid : -1; };
+	sim.run_before(start);
+	size_t previous_pending = sim.status().runnable;
+	int32_t previous_running = running_pid();
+	BoundaryState previous = boundary_state(slots, sim, start);
+	bool has_previous = true;
+	const int GIVE_UP_GROWTH = 3;
+	int growing = 0;
+	SimStats previous_stats = sim.stats();
+	for (size_t k = 1; k <= windows && growing < GIVE_UP_GROWTH; ++k) {
+		double_t boundary = start + k * window;
+		sim.run_before(boundary);
+		result.simulated_windows++;
+
+		size_t pending = sim.status().runnable;
+		int32_t running = running_pid();
+		if (pending > previous_pending) growing++;
+		else if (pending < previous_pending) growing = 0;
+		if (pending == previous_pending && running == previous_running) {
+			BoundaryState state = boundary_state(slots, sim, boundary);
+			if (k < windows && has_previous && same_state(state, previous)) {
+				// ʣµģͬβһڵĲִӵǰ״̬ģ
+				result.skipped_windows = windows - k;
+				SimStats base = sim.stats();
+				sim.run_before(boundary + (horizon - start - windows * window));
+				result.stats = base;
+				add_scaled(result.stats, base, previous_stats, static_cast<double_t>(result.skipped_windows));
+				add_scaled(result.stats, sim.stats(), base, 1);
+				result.pending = pending_jobs(slots, sim.now());
+				return result;
+			}
+			std::swap(previous, state);
+			has_previous = true;
+		}
+		else {
+			has_previous = false;
+		}
+		previous_pending = pending;
+		previous_running = running;
+		previous_stats = sim.stats();
+	}
+
+	sim.run_before(horizon);
+	result.stats = sim.stats();
+	result.pending = pending_jobs(slots, horizon);
+	return result;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+#include "ready_queue.h"
+
+// ÿ period ͷһҵҵҪ wcetͷź deadline 
+struct PeriodicTask {
+	int32_t pid = 0;
+	double_t period = 0;
+	double_t wcet = 0;      //ִʱ䣬ģÿҵ
+	double_t deadline = 0;  //Խֹʱ䣬<= 0 ʾ
+	double_t phase = 0;     //һҵͷʱ
+
+	double_t relative_deadline() const { return deadline > 0 ? deadline : period; }
+};
+
+// ļÿ "pid period wcet [deadline [phase]]"# ͷΪע
+bool load_tasks(const std::string& path, std::vector<PeriodicTask>& tasks);
+
+// ڶʱǵС򣨻򳬹 2^53 0
+double_t hyperperiod(const std::vector<PeriodicTask>& tasks);
+
+// ɵԷRMS ԽȼԽߣͬ˳򣩡
+struct Schedulability {
+	double_t utilization = 0;        // C/T
+	double_t density = 0;            // C/min(D, T)
+	double_t liu_layland = 0;        //n(2^(1/n) - 1)
+	bool rms_liu_layland = false;    //U  Liu-Layland 磬Ҫ D >= T
+	bool rms_response_time = false;  //ӦʱͬʱͷʱǾȷ
+	bool edf = false;                //D >= T ʱ U <= 1 Ϊȷܶ <= 1 ĳ
+	std::vector<double_t> response_times; // RMS µӦʱ䣬ֹʱ伴ֹͣ
+};
+
+Schedulability analyze(const std::vector<PeriodicTask>& tasks);
+
+// չɰͷʱҵֻͷ horizon ֮ǰҵ
+// ҵ pid Ϊ pidpriority Ϊ RMS ȼԽԽ󣩣deadline ΪԽֹʱ䡣
+class PeriodicSource : public WorkloadSource {
+public:
+	PeriodicSource(const std::vector<PeriodicTask>& tasks, double_t horizon);
+
+	size_t size() const override { return total; }
+	bool next(PCB& process) override;
+
+private:
+	std::vector<PeriodicTask> tasks;
+	std::vector<int32_t> rm_priority;
+	std::vector<uint64_t> released;   //ͷŵҵͷʱ = phase + released * periodۼ
+	std::priority_queue<std::pair<double_t, size_t>, std::vector<std::pair<double_t, size_t>>,
+		std::greater<std::pair<double_t, size_t>>> upcoming; //(һͷʱ, )
+	double_t horizon = 0;
+	size_t total = 0;
+};
+
+// ֹʱȣҵԽֹʱڴĶҵֹʱʱռ
+// ûнֹʱĽ󣬱˴˰˳
+class EdfScheduler final : public Scheduler {
+public:
+	const char* name() const override { return "EDF"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override { ready.push(id); }
+	int32_t pick_next(double_t now) override { return ready.empty() ? -1 : ready.pop(); }
+	double_t time_slice(int32_t id, double_t now) override { return RUN_TO_END; }
+	void on_requeue(int32_t id, double_t now) override { ready.push(id); }
+	bool should_preempt(int32_t running, int32_t arrived, double_t now) override { return ready.order()(arrived, running); }
+
+	void save(SnapshotWriter& out) const override { ready.save(out); }
+	bool load(SnapshotReader& in) override { return ready.load(in); }
+
+private:
+	// ֹʱ䡢pidʱαȽϣλ±֤꣬ͬľ״̬ͬѡ
+	struct DeadlineOrder {
+		const std::vector<PCB>* process_list = nullptr;
+
+		bool operator()(int32_t a, int32_t b) const {
+			const PCB& pa = (*process_list)[a];
+			const PCB& pb = (*process_list)[b];
+			double_t da = pa.deadline >= 0 ? pa.deadline : RUN_TO_END;
+			double_t db = pb.deadline >= 0 ? pb.deadline : RUN_TO_END;
+			if (da != db) return da < db;
+			if (pa.pid != pb.pid) return pa.pid < pb.pid;
+			if (pa.arrival != pb.arrival) return pa.arrival < pb.arrival;
+			return a < b;
+		}
+	};
+
+	IndexedHeap<DeadlineOrder> ready;
+};
+
+// ʵȣ̶ȼռʽȣȼȡ PeriodicSource ڸ priority
+// ͨʱǲб仯ռʽȡ
+class RmsScheduler final : public Scheduler {
+public:
+	const char* name() const override { return "RMS"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override { ready.push(id); }
+	int32_t pick_next(double_t now) override { return ready.empty() ? -1 : ready.pop(); }
+	double_t time_slice(int32_t id, double_t now) override { return RUN_TO_END; }
+	void on_requeue(int32_t id, double_t now) override { ready.push(id); }
+	bool should_preempt(int32_t running, int32_t arrived, double_t now) override { return ready.order()(arrived, running); }
+
+	void save(SnapshotWriter& out) const override { ready.save(out); }
+	bool load(SnapshotReader& in) override { return ready.load(in); }
+
+private:
+	struct FixedPriorityOrder {
+		const std::vector<PCB>* process_list = nullptr;
+
+		bool operator()(int32_t a, int32_t b) const {
+			const PCB& pa = (*process_list)[a];
+			const PCB& pb = (*process_list)[b];
+			if (pa.priority != pb.priority) return pa.priority > pb.priority;
+			if (pa.pid != pb.pid) return pa.pid < pb.pid;
+			if (pa.arrival != pb.arrival) return pa.arrival < pb.arrival;
+			return a < b;
+		}
+	};
+
+	IndexedHeap<FixedPriorityOrder> ready;
+};
+
+struct RealTimeConfig {
+	double_t horizon = 0;      //ģʱ0 ʾλһڣڲʱ 100 ڣ
+	bool skip_repeats = true;  //ڱ߽ϵľ״̬ͬʱ֮ĳֱӰǰһ
+	SimConfig sim;
+};
+
+struct RealTimeResult {
+	SimStats stats;               //[0, horizon) ڵͳƣnow  horizon
+	double_t hyperperiod = 0;
+	size_t simulated_windows = 0; //ʵ¼ģĳ
+	size_t skipped_windows = 0;   //ĳ
+	size_t pending = 0;           //horizon ʱͷŵδɵҵֹʱͳ
+};
+
+// ģ⡣ȲȷԵģEDFRMS ȣڲ¼ģһ¡
+RealTimeResult run_realtime(const std::vector<PeriodicTask>& tasks, Scheduler& scheduler,
+	const RealTimeConfig& config = RealTimeConfig());
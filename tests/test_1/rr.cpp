@@ -0,0 +1,6 @@
+#include "rr.h"
+
+void RoundRobinScheduler::reset(std::vector<PCB>& process_list) {
+	ready.clear();
+	ready.reserve(process_list.size());
+}
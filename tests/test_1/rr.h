@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../common/snapshot.h"
+#include "engine.h"
+#include "pcb.h"
+
+// ±ĻζУΪ 2 ݡֻзʱݣreset ʱԤãвٷ䡣
+class IndexRing {
+public:
+	void reserve(size_t n) {
+		if (n <= slots.size()) return;
+		size_t capacity = slots.empty() ? 16 : slots.size();
+		while (capacity < n) capacity <<= 1;
+		grow(capacity);
+	}
+
+	void clear() { head = 0; count = 0; }
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+
+	void push_back(int32_t id) {
+		if (count == slots.size()) grow(slots.empty() ? 16 : slots.size() * 2);
+		slots[(head + count) & (slots.size() - 1)] = id;
+		count++;
+	}
+
+	int32_t pop_front() {
+		int32_t id = slots[head];
+		head = (head + 1) & (slots.size() - 1);
+		count--;
+		return id;
+	}
+
+	// ˳򱣴棬ʱ鿪ͷ
+	void save(SnapshotWriter& out) const {
+		std::vector<int32_t> ids(count);
+		for (size_t i = 0; i < count; ++i) ids[i] = slots[(head + i) & (slots.size() - 1)];
+		out.put_array(ids);
+	}
+
+	bool load(SnapshotReader& in) {
+		std::vector<int32_t> ids;
+		if (!in.get_array(ids)) return false;
+		clear();
+		reserve(ids.size());
+		for (int32_t id : ids) push_back(id);
+		return true;
+	}
+
+private:
+	// ˳ᵽĿͷ
+	void grow(size_t capacity) {
+		std::vector<int32_t> bigger(capacity);
+		for (size_t i = 0; i < count; ++i) bigger[i] = slots[(head + i) & (slots.size() - 1)];
+		slots.swap(bigger);
+		head = 0;
+	}
+
+	std::vector<int32_t> slots;
+	size_t head = 0;
+	size_t count = 0;
+};
+
+struct RrConfig {
+	double_t quantum = 4; //ʱƬ<= 0 ʱ˻Ϊȷ
+};
+
+// ʱƬתųһ FIFO ÿһʱƬصβ
+// лĿ水 SimConfig::context_switch 룬޹ء
+class RoundRobinScheduler final : public Scheduler {
+public:
+	explicit RoundRobinScheduler(const RrConfig& config = RrConfig()) : config(config) {}
+
+	const char* name() const override { return "RR"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override { ready.push_back(id); }
+	int32_t pick_next(double_t now) override { return ready.empty() ? -1 : ready.pop_front(); }
+	double_t time_slice(int32_t id, double_t now) override { return config.quantum > 0 ? config.quantum : RUN_TO_END; }
+	void on_requeue(int32_t id, double_t now) override { ready.push_back(id); }
+
+	void save(SnapshotWriter& out) const override { ready.save(out); }
+	bool load(SnapshotReader& in) override { return ready.load(in); }
+
+private:
+	RrConfig config;
+	IndexRing ready;
+};
@@ -0,0 +1,115 @@
+#include "scheduling.h"
+
+#include <algorithm>
+
+bool process_finish(std::vector<PCB>& process_list) { //Ƿ
+	for (auto& i : process_list) {
+		if (i.state == State::R) return false;
+	}
+
+	return true;
+}
+
+bool process_finish(const ProcessStatus& status) {
+	return status.done();
+}
+
+// ֻڽʱɨһΣ֮ɵȲά
+ProcessStatus count_processes(const std::vector<PCB>& process_list) {
+	ProcessStatus status;
+	status.total = process_list.size();
+	for (const auto& process : process_list) {
+		if (process.state == State::E) status.finished++;
+		else status.runnable++;
+	}
+	return status;
+}
+
+void build_ready_queue(const std::vector<PCB>& process_list, ReadyQueue& ready_queue) {
+	ready_queue.order().process_list = &process_list;
+
+	std::vector<int32_t> ready;
+	ready.reserve(process_list.size());
+	for (size_t i = 0; i < process_list.size(); ++i) {
+		if (process_list[i].state == State::R) ready.push_back(static_cast<int32_t>(i));
+	}
+	ready_queue.reserve(process_list.size());
+	ready_queue.assign(ready.begin(), ready.end());
+}
+
+void priority_scheduling_step(std::vector<PCB>& process_list, ReadyQueue& ready_queue, ProcessStatus& status) {
+	if (ready_queue.empty()) return;
+
+	// ÿֻһȼĽ
+	int32_t top = ready_queue.top();
+	process_list[top].run_process();
+	status.now++;
+
+	if (process_list[top].state == State::E) { // Ľ뿪
+		ready_queue.pop();
+		status.runnable--;
+		status.finished++;
+	}
+	else {
+		ready_queue.update(top);                // ȼͣ³
+	}
+}
+
+void PriorityScheduler::reset(std::vector<PCB>& process_list) {
+	this->process_list = &process_list;
+	ready_queue.clear();
+	ready_queue.order().process_list = &process_list;
+	ready_queue.reserve(process_list.size());
+
+	base_priority.resize(process_list.size());
+	for (size_t i = 0; i < process_list.size(); ++i) {
+		base_priority[i] = process_list[i].priority + static_cast<int32_t>(std::floor(process_list[i].cpu_time));
+	}
+}
+
+void PriorityScheduler::on_arrival(int32_t id, double_t now) {
+	// ʽ±ܳ reset ʱķΧǸõĲλ
+	const PCB& process = (*process_list)[id];
+	if (static_cast<size_t>(id) >= base_priority.size()) base_priority.resize(id + 1);
+	base_priority[id] = process.priority + static_cast<int32_t>(std::floor(process.cpu_time));
+	ready_queue.push(id);
+}
+
+int32_t PriorityScheduler::pick_next(double_t now) {
+	if (ready_queue.empty()) return -1;
+	return ready_queue.pop();
+}
+
+double_t PriorityScheduler::time_slice(int32_t id, double_t now) {
+	if (ready_queue.empty()) return RUN_TO_END;
+
+	// еȼڣ pid һѡΪֹpid ͬͬһĶҵʱ߲Ⱥ
+	// ڴ㳤ȵʱƬлʱӲǰ pid Сһ
+	const PCB& process = (*process_list)[id];
+	const PCB& next = (*process_list)[ready_queue.top()];
+	double_t lose_at = base_priority[id] - next.priority + (process.pid <= next.pid ? 1 : 0);
+	return std::max(lose_at - process.cpu_time, 0.0);
+}
+
+void PriorityScheduler::on_run(int32_t id, double_t ran, double_t now) {
+	PCB& process = (*process_list)[id];
+	process.priority = base_priority[id] - static_cast<int32_t>(std::floor(process.cpu_time + 1e-9));
+}
+
+void PriorityScheduler::on_requeue(int32_t id, double_t now) {
+	ready_queue.push(id);
+}
+
+bool PriorityScheduler::should_preempt(int32_t running, int32_t arrived, double_t now) {
+	// ½̳ΪһѡʱǰȵʱˣҪµ
+	return ready_queue.top() == arrived;
+}
+
+void PriorityScheduler::save(SnapshotWriter& out) const {
+	out.put_array(base_priority);
+	ready_queue.save(out);
+}
+
+bool PriorityScheduler::load(SnapshotReader& in) {
+	return in.get_array(base_priority) && ready_queue.load(in);
+}
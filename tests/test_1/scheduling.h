@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+#include "ready_queue.h"
+
+bool process_finish(std::vector<PCB>& process_list);
+bool process_finish(const ProcessStatus& status);
+ProcessStatus count_processes(const std::vector<PCB>& process_list);
+void build_ready_queue(const std::vector<PCB>& process_list, ReadyQueue& ready_queue);
+void priority_scheduling_step(std::vector<PCB>& process_list, ReadyQueue& ready_queue, ProcessStatus& status);
+
+// ¼汾ȣ priority_scheduling_step ͬÿһλȼһ
+// ֱǰ̻ȶãһ¼
+class PriorityScheduler final : public Scheduler {
+public:
+	const char* name() const override { return "Priority"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override;
+	int32_t pick_next(double_t now) override;
+	double_t time_slice(int32_t id, double_t now) override;
+	void on_run(int32_t id, double_t ran, double_t now) override;
+	void on_requeue(int32_t id, double_t now) override;
+	bool should_preempt(int32_t running, int32_t arrived, double_t now) override;
+
+	void save(SnapshotWriter& out) const override;
+	bool load(SnapshotReader& in) override;
+
+private:
+	std::vector<PCB>* process_list = nullptr;
+	std::vector<int32_t> base_priority; //ȼ = base_priority - еλ
+	ReadyQueue ready_queue;
+};
@@ -0,0 +1,221 @@
+#include "sim_thread.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "scheduling.h"
+
+using Clock = std::chrono::steady_clock;
+
+SimThread::SimThread() {
+	publish();
+	worker = std::thread([this] { run(); });
+}
+
+SimThread::~SimThread() {
+	{
+		std::lock_guard<std::mutex> lock(command_mutex);
+		quit = true;
+	}
+	wake.notify_one();
+	worker.join();
+}
+
+void SimThread::load(const std::vector<PCB>& process_list) {
+	{
+		std::lock_guard<std::mutex> lock(command_mutex);
+		pending_load = process_list;
+		load_requested = true;
+		running.store(false, std::memory_order_relaxed);
+	}
+	wake.notify_one();
+}
+
+void SimThread::start() {
+	{
+		std::lock_guard<std::mutex> lock(command_mutex); //ģ̼߳ȴ⣬ⶪʧ
+		running.store(true, std::memory_order_relaxed);
+		pending_scrub = -1;
+		scrub_requested = true;
+	}
+	wake.notify_one();
+}
+
+void SimThread::pause() {
+	running.store(false, std::memory_order_relaxed);
+}
+
+void SimThread::step_once() {
+	{
+		std::lock_guard<std::mutex> lock(command_mutex);
+		pending_steps++;
+		running.store(false, std::memory_order_relaxed);
+	}
+	wake.notify_one();
+}
+
+void SimThread::scrub(int64_t tick) {
+	{
+		std::lock_guard<std::mutex> lock(command_mutex);
+		pending_scrub = tick;
+		scrub_requested = true;
+		if (tick >= 0) running.store(false, std::memory_order_relaxed);
+	}
+	wake.notify_one();
+}
+
+void SimThread::step() {
+	int32_t top = ready_queue.empty() ? -1 : ready_queue.top();
+	TickRecord record;
+	record.tick = ticks;
+	record.id = top;
+	record.priority = top >= 0 ? process_list[top].priority : 0;
+	double_t before = status.now;
+	priority_scheduling_step(process_list, ready_queue, status);
+	if (top >= 0) timeline.add(top, before, status.now);
+	ticks++;
+
+	record.now = status.now;
+	tick_log.push(record);
+	if (keyframes.due(ticks)) save_keyframe(ticks);
+}
+
+void SimThread::save_keyframe(uint64_t index) {
+	SnapshotWriter& out = keyframes.begin(index, status.now);
+	out.put_array(process_list);
+	ready_queue.save(out);
+	out.put(status);
+	keyframes.end();
+}
+
+// Ӳ tick ؼָ֡ͬĲطŵ tick
+bool SimThread::seek(uint64_t tick) {
+	const Keyframe* frame = keyframes.at_or_before(std::min(tick, ticks));
+	if (!frame) return false;
+	SnapshotReader in = keyframes.open(*frame);
+	if (!in.get_array(view_list) || !view_queue.load(in) || !in.get(view_status)) return false;
+	view_queue.order().process_list = &view_list;
+	view_ticks = frame->index;
+	while (view_ticks < tick && view_ticks < ticks) {
+		priority_scheduling_step(view_list, view_queue, view_status);
+		view_ticks++;
+	}
+	return true;
+}
+
+void SimThread::publish() {
+	SimSnapshot& snapshot = snapshots.write_buffer();
+	snapshot.process_list = scrubbing ? view_list : process_list; //СʱеĿռ
+	snapshot.status = scrubbing ? view_status : status;
+	snapshot.timeline.sync(timeline); //ֻ׷ϴη֮Ķ
+	snapshot.ticks = scrubbing ? view_ticks : ticks;
+	snapshot.steps_per_second = steps_per_second;
+	snapshot.steps_per_frame = steps_per_frame;
+	snapshot.running = running.load(std::memory_order_relaxed) && !status.done();
+	snapshot.scrubbing = scrubbing;
+	snapshot.live_ticks = ticks;
+	snapshot.history_begin = keyframes.oldest() ? keyframes.oldest()->index : ticks;
+
+	// ļ¼ѱλǵĲʾ
+	snapshot.recent.clear();
+	uint64_t end = snapshot.ticks;
+	uint64_t begin = std::max(tick_log.first(), end > RECENT_TICKS ? end - RECENT_TICKS : 0);
+	for (uint64_t i = begin; i < end; ++i) snapshot.recent.push_back(tick_log.at(i));
+	snapshots.publish();
+}
+
+void SimThread::run() {
+	// ֡Ҫ״̬֡ʸƵҲ
+	const auto frame = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1 / BASE_RATE));
+
+	Clock::time_point next_step = Clock::now();
+	Clock::time_point rate_start = next_step;
+	uint64_t rate_ticks = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(command_mutex);
+			if (quit) return;
+			if (load_requested) {
+				process_list.swap(pending_load);
+				build_ready_queue(process_list, ready_queue);
+				status = count_processes(process_list);
+				timeline.clear();
+				ticks = 0;
+				tick_log.clear();
+				keyframes.clear();
+				save_keyframe(0);
+				scrubbing = false;
+				load_requested = false;
+				lock.unlock();
+				publish();
+				continue;
+			}
+			if (scrub_requested) {
+				int64_t tick = pending_scrub;
+				scrub_requested = false;
+				lock.unlock();
+				scrubbing = tick >= 0 && seek(static_cast<uint64_t>(tick));
+				publish();
+				continue;
+			}
+			if (pending_steps) {
+				uint32_t steps = pending_steps;
+				pending_steps = 0;
+				lock.unlock();
+				scrubbing = false;
+				for (uint32_t i = 0; i < steps && !status.done(); ++i) step();
+				steps_per_frame = steps;
+				publish();
+				continue;
+			}
+			if (!running.load(std::memory_order_relaxed) || status.done()) {
+				steps_per_second = 0;
+				publish();
+				wake.wait(lock, [this] {
+					return quit || load_requested || scrub_requested || pending_steps || (running.load(std::memory_order_relaxed) && !status.done());
+				});
+				next_step = rate_start = Clock::now();
+				rate_ticks = ticks;
+				continue;
+			}
+		}
+
+		Clock::time_point now = Clock::now();
+		uint64_t batch_start = ticks;
+		if (fast_forward.load(std::memory_order_relaxed)) {
+			// ÿ 256 һʱӣܱʱʱӵĿԺԣԤҲ 256 
+			Clock::time_point until = now + FRAME_BUDGET;
+			do {
+				for (int i = 0; i < 256 && !status.done(); ++i) step();
+			} while (!status.done() && running.load(std::memory_order_relaxed) && Clock::now() < until);
+			next_step = std::max(now + frame, Clock::now());
+		}
+		else {
+			// ̶ϵΪֹӦߵĲ̫ʱ׷ϣ⿨ٺͻȻ
+			auto interval = std::chrono::duration_cast<Clock::duration>(
+				std::chrono::duration<double>(1.0 / (BASE_RATE * std::max(speed.load(std::memory_order_relaxed), 1e-3))));
+			int due = 0;
+			while (next_step <= now && due < 10000) {
+				next_step += interval;
+				due++;
+			}
+			if (next_step <= now) next_step = now + interval;
+			for (int i = 0; i < due && !status.done(); ++i) step();
+		}
+
+		steps_per_frame = ticks - batch_start;
+		now = Clock::now();
+		double elapsed = std::chrono::duration<double>(now - rate_start).count();
+		if (elapsed >= 1) {
+			steps_per_second = (ticks - rate_ticks) / elapsed;
+			rate_start = now;
+			rate_ticks = ticks;
+		}
+		publish();
+
+		std::unique_lock<std::mutex> lock(command_mutex);
+		wake.wait_until(lock, next_step, [this] {
+			return quit || load_requested || scrub_requested || pending_steps || !running.load(std::memory_order_relaxed);
+			});
+	}
+}
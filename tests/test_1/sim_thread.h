@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common/replay.h"
+#include "pcb.h"
+#include "ready_queue.h"
+#include "timeline.h"
+#include "triple_buffer.h"
+
+// λģÿһļ¼ tick еḶ̌-1 ΪУǰȼ
+struct TickRecord {
+	uint64_t tick = 0;
+	double now = 0;       //һʱģʱ
+	int32_t id = -1;
+	int32_t priority = 0;
+};
+
+static_assert(sizeof(TickRecord) == 24, "TickRecord layout");
+
+// ÿ֡ģ״̬
+struct SimSnapshot {
+	std::vector<PCB> process_list;
+	ProcessStatus status;
+	Timeline timeline;            //λеʷڵλѺϲ
+	uint64_t ticks = 0;
+	double steps_per_second = 0;  //һʵʵĲٶ
+	uint64_t steps_per_frame = 0; //һߵĲ
+	bool running = false;
+
+	// ؿʷʱǵ ticks ״̬timeline ʷ
+	bool scrubbing = false;
+	uint64_t live_ticks = 0;      //ģʵߵĲ
+	uint64_t history_begin = 0;   //ܻؿĲ
+	std::vector<TickRecord> recent; //ticks ֮ǰɲµں
+};
+
+// λȷڶ߳ϰ̶ƽȾ֡޹ء
+// ٶΪÿ BASE_RATE * speed ԭÿ֡һ 60 ֡ƣʱÿ֡1 / BASE_RATE 룩
+//  FRAME_BUDGET ߾ܶĲٷʱպͽ̡߳
+// ÿ״̬ддٷʱֻ׷ӸûȱٵĶΣֻ߳գ߻ȴ
+// ÿһλ׷һ TickRecordʱԤԴؼ֡ؿһʱ֮ǰĹؼ֡طš
+class SimThread {
+public:
+	static constexpr double BASE_RATE = 60;
+	static constexpr size_t RECENT_TICKS = 16;
+	static constexpr std::chrono::milliseconds FRAME_BUDGET{ 12 };
+
+	SimThread();
+	~SimThread();
+
+	SimThread(const SimThread&) = delete;
+	SimThread& operator=(const SimThread&) = delete;
+
+	// ɽ̵߳áload 滻ģеḺ̌ͣģ߳һѭʱЧ
+	void load(const std::vector<PCB>& process_list);
+	void start();
+	void pause();
+	void scrub(int64_t tick); //ؿ tick ֮״̬ͣ-1 صǰ״̬start Ҳصǰ״̬
+	void set_speed(double speed) { this->speed.store(speed, std::memory_order_relaxed); }
+	void set_fast_forward(bool fast_forward) { this->fast_forward.store(fast_forward, std::memory_order_relaxed); }
+	void step_once(); //ͣʱǰһؿʷʱȻصǰ״̬
+
+	const SimSnapshot& snapshot() { return snapshots.read(); }
+
+private:
+	void run();
+	void step();
+	void publish();
+	void save_keyframe(uint64_t index);
+	bool seek(uint64_t tick);
+
+	// ߳ -> ģ̵߳ٷûͷղ
+	std::mutex command_mutex;
+	std::condition_variable wake;
+	std::vector<PCB> pending_load;
+	bool load_requested = false;
+	uint32_t pending_steps = 0;
+	int64_t pending_scrub = -1;
+	bool scrub_requested = false;
+	bool quit = false;
+
+	std::atomic<bool> running{ false };
+	std::atomic<double> speed{ 1 };
+	std::atomic<bool> fast_forward{ false };
+
+	// ֻģ̷߳
+	std::vector<PCB> process_list;
+	ReadyQueue ready_queue;
+	ProcessStatus status;
+	Timeline timeline;
+	uint64_t ticks = 0;
+	double steps_per_second = 0;
+	uint64_t steps_per_frame = 0;
+
+	EventRing<TickRecord> tick_log;
+	KeyframeStore keyframes{ SNAPSHOT_TICKS };
+
+	// ؿʱطų״̬ready_queue ıȽָ view_list
+	bool scrubbing = false;
+	std::vector<PCB> view_list;
+	ReadyQueue view_queue;
+	ProcessStatus view_status;
+	uint64_t view_ticks = 0;
+
+	TripleBuffer<SimSnapshot> snapshots;
+	std::thread worker;
+};
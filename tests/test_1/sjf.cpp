@@ -0,0 +1,94 @@
+#include "sjf.h"
+
+#include <algorithm>
+#include <cmath>
+
+void SjfScheduler::reset(std::vector<PCB>& process_list) {
+	this->process_list = &process_list;
+	ready = IndexedHeap<EstimateOrder>(EstimateOrder{ &process_list, &key });
+	ready.reserve(process_list.size());
+	key.assign(process_list.size(), 0);
+	tau.assign(process_list.size(), 0);
+	burst_run.assign(process_list.size(), 0);
+	error.assign(process_list.size(), 1);
+	average = 0;
+	has_average = false;
+	gen.seed(config.seed);
+}
+
+void SjfScheduler::start_burst(int32_t id) {
+	burst_run[id] = 0;
+	if (config.predict || config.error_cv <= 0) return;
+	double_t sigma2 = std::log(1 + config.error_cv * config.error_cv);
+	error[id] = std::lognormal_distribution<double_t>(-sigma2 / 2, std::sqrt(sigma2))(gen);
+}
+
+void SjfScheduler::end_burst(int32_t id) {
+	double_t burst = burst_run[id];
+	tau[id] = config.alpha * burst + (1 - config.alpha) * tau[id];
+	average = has_average ? config.alpha * burst + (1 - config.alpha) * average : burst;
+	has_average = true;
+	burst_run[id] = 0;
+}
+
+void SjfScheduler::on_arrival(int32_t id, double_t now) {
+	// ʽػḴòλʱ³ʼòλϢ
+	if (static_cast<size_t>(id) >= key.size()) {
+		size_t n = static_cast<size_t>(id) + 1;
+		key.resize(n, 0);
+		tau.resize(n, 0);
+		burst_run.resize(n, 0);
+		error.resize(n, 1);
+	}
+	tau[id] = config.initial_estimate > 0 ? config.initial_estimate : average;
+	error[id] = 1;
+	start_burst(id);
+	enqueue(id);
+}
+
+void SjfScheduler::on_wakeup(int32_t id, double_t now) {
+	start_burst(id);
+	enqueue(id);
+}
+
+double_t SjfScheduler::estimate(int32_t id) const {
+	if (config.predict) {
+		double_t run = burst_run[id];
+		return tau[id] > run ? tau[id] - run : run;
+	}
+	const PCB& process = (*process_list)[id];
+	double_t left = process.all_time;
+	if (process.io_every > 0) left = std::min(left, process.until_io);
+	return left * error[id];
+}
+
+void SjfScheduler::enqueue(int32_t id) {
+	key[id] = estimate(id);
+	ready.push(id);
+}
+
+bool SjfScheduler::should_preempt(int32_t running, int32_t arrived, double_t now) {
+	return config.preemptive && estimate(arrived) < estimate(running);
+}
+
+void SjfScheduler::save(SnapshotWriter& out) const {
+	ready.save(out);
+	out.put_array(key);
+	out.put_array(tau);
+	out.put_array(burst_run);
+	out.put_array(error);
+	out.put(average);
+	out.put(has_average);
+	out.put_engine(gen);
+}
+
+bool SjfScheduler::load(SnapshotReader& in) {
+	ready.load(in);
+	in.get_array(key);
+	in.get_array(tau);
+	in.get_array(burst_run);
+	in.get_array(error);
+	in.get(average);
+	in.get(has_average);
+	return in.get_engine(gen);
+}
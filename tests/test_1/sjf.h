@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+#include "ready_queue.h"
+
+struct SjfConfig {
+	bool preemptive = false;     //SRTFµ I/O ɵĽ̹ʣʱʱռ
+	bool predict = false;        //ʵ CPU 䣬ָƽԤ
+	double_t alpha = 0.5;        //(n+1) =  t(n) + (1 - ) (n)
+	double_t initial_estimate = 0; //½̵ 0<= 0 ʱнָƽ
+	double_t error_cv = 0;       //ԤʱʵϾֵΪ 1ϵΪ error_cv Ķ̬Ӱ
+	uint64_t seed = 1;
+};
+
+// ҵ / ʣʱȡCPU ָӾ֮Ҫ CPU ʱ
+//  I/O ĽΪ min(ʣʱ, һ I/O)̰ƵʣڴС
+// ͬʱ pidʱȽϣλ±޹ء
+// Ԥģʽÿʱʵʳȸ¸ý̵ ӣг  еʱʣ
+// βֲʣʱеʱȣΪƽ 0 ռ
+class SjfScheduler final : public Scheduler {
+public:
+	explicit SjfScheduler(const SjfConfig& config = SjfConfig()) : config(config), gen(config.seed) {}
+
+	const char* name() const override { return config.preemptive ? "SRTF" : "SJF"; }
+	void reset(std::vector<PCB>& process_list) override;
+
+	void on_arrival(int32_t id, double_t now) override;
+	int32_t pick_next(double_t now) override { return ready.empty() ? -1 : ready.pop(); }
+	double_t time_slice(int32_t id, double_t now) override { return RUN_TO_END; }
+	void on_run(int32_t id, double_t ran, double_t now) override { burst_run[id] += ran; }
+	void on_requeue(int32_t id, double_t now) override { enqueue(id); }
+	void on_finish(int32_t id, double_t now) override { end_burst(id); }
+	void on_block(int32_t id, double_t now) override { end_burst(id); }
+	void on_wakeup(int32_t id, double_t now) override;
+	bool should_preempt(int32_t running, int32_t arrived, double_t now) override;
+
+	void save(SnapshotWriter& out) const override;
+	bool load(SnapshotReader& in) override;
+
+	double_t estimate(int32_t id) const; //ǰ CPU ƻҪʱ
+
+private:
+	struct EstimateOrder {
+		const std::vector<PCB>* process_list = nullptr;
+		const std::vector<double_t>* key = nullptr;
+
+		bool operator()(int32_t a, int32_t b) const {
+			double_t ka = (*key)[a], kb = (*key)[b];
+			if (ka != kb) return ka < kb;
+			const PCB& pa = (*process_list)[a];
+			const PCB& pb = (*process_list)[b];
+			if (pa.pid != pb.pid) return pa.pid < pb.pid;
+			if (pa.arrival != pb.arrival) return pa.arrival < pb.arrival;
+			return a < b;
+		}
+	};
+
+	void start_burst(int32_t id);
+	void end_burst(int32_t id);
+	void enqueue(int32_t id);
+
+	SjfConfig config;
+	std::vector<PCB>* process_list = nullptr;
+	IndexedHeap<EstimateOrder> ready;
+	std::vector<double_t> key;        //ʱĹƣѰ
+	std::vector<double_t> tau;        //Ԥı䳤
+	std::vector<double_t> burst_run;  //еʱ
+	std::vector<double_t> error;      //Ĺϵ
+	double_t average = 0;             //нָƽ
+	bool has_average = false;
+	std::mt19937_64 gen;
+};
@@ -0,0 +1,150 @@
+#include "sweep.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "policies.h"
+#include "thread_pool.h"
+#include "workload.h"
+
+std::vector<SweepResult> run_sweep(const SweepGrid& grid, size_t threads) {
+	std::vector<SweepResult> results;
+	for (const auto& policy : grid.policies) {
+		for (double_t quantum : grid.quanta) {
+			for (size_t processes : grid.process_counts) {
+				for (double_t io_bound : grid.io_bound) {
+					for (uint32_t seed : grid.seeds) {
+						SweepResult result;
+						result.policy = policy;
+						result.seed = seed;
+						result.quantum = quantum;
+						result.processes = processes;
+						result.io_bound = io_bound;
+						results.push_back(result);
+					}
+				}
+			}
+		}
+	}
+
+	// ϰ policyquantumprocessesio_boundseed ˳չͬһϻɵһʱƬ±
+	size_t per_quantum = grid.process_counts.size() * grid.io_bound.size() * grid.seeds.size();
+	size_t per_policy = grid.quanta.size() * per_quantum;
+	auto base_of = [per_quantum, per_policy](size_t i) { return i / per_policy * per_policy + i % per_quantum; };
+
+	// غֻϾԤȺͷֲģ⿴ͬһݸ
+	auto make_sim = [&grid](const SweepResult& result, std::vector<PCB>& process_list, bool with_workload) {
+		SimConfig sim_config = grid.sim;
+		sim_config.io_seed = result.seed;
+		if (with_workload) {
+			process_list = random_workload(result.processes, result.seed, grid.mean_gap);
+			IoMix io = grid.io;
+			io.io_bound = result.io_bound;
+			if (io.io_bound > 0) assign_io(process_list, io, result.seed);
+		}
+		PolicyConfig config;
+		set_quantum(config, result.quantum);
+		config.proportional.seed = result.seed;
+		return make_simulator(result.policy, config, process_list, sim_config);
+	};
+
+	// ʶĲͶǰͱǳռ̳߳
+	for (auto& result : results) {
+		if (!make_scheduler(result.policy)) result.error = "unknown policy";
+	}
+
+	ThreadPool pool(threads);
+	std::vector<std::vector<char>> snapshots(results.size());
+	if (grid.warmup > 0) {
+		for (size_t i = 0; i < results.size(); ++i) {
+			if (base_of(i) != i || !results[i].ok()) continue;
+			pool.submit([&results, &snapshots, &make_sim, &grid, i] {
+				std::vector<PCB> process_list;
+				std::unique_ptr<AnySimulator> sim = make_sim(results[i], process_list, true);
+				if (!sim) {
+					results[i].error = "unknown policy";
+					return;
+				}
+				sim->run_before(grid.warmup);
+				SnapshotWriter out(SNAPSHOT_SCHEDULER);
+				sim->save(out);
+				snapshots[i] = out.data();
+				});
+		}
+		pool.wait();
+	}
+
+	for (size_t i = 0; i < results.size(); ++i) {
+		if (!results[i].ok()) continue;
+		pool.submit([&results, &snapshots, &make_sim, &grid, &base_of, i] {
+			SweepResult* result = &results[i];
+			auto begin = std::chrono::steady_clock::now();
+
+			std::vector<PCB> process_list;
+			const std::vector<char>& snapshot = snapshots[base_of(i)];
+			bool fork = grid.warmup > 0;
+			std::unique_ptr<AnySimulator> sim = make_sim(*result, process_list, !fork);
+			if (!sim) {
+				result->error = "unknown policy";
+				return;
+			}
+			if (fork) {
+				// ԤʧʱΪգȡͬʧ
+				SnapshotReader in(snapshot, SNAPSHOT_SCHEDULER);
+				if (!sim->load(in)) {
+					result->error = "failed to load warm-up snapshot";
+					return;
+				}
+			}
+
+			sim->run();
+			result->stats = sim->stats();
+			result->latency = sim->latency();
+			result->fairness = slowdown_fairness(process_list);
+			result->wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+			});
+	}
+	pool.wait();
+
+	return results;
+}
+
+std::vector<SweepResult> merge_seeds(const std::vector<SweepResult>& results) {
+	std::vector<SweepResult> merged;
+	for (const auto& result : results) {
+		if (!result.ok()) continue;
+		auto same = [&result](const SweepResult& r) {
+			return r.policy == result.policy && r.quantum == result.quantum && r.processes == result.processes &&
+				r.io_bound == result.io_bound;
+		};
+		auto it = std::find_if(merged.begin(), merged.end(), same);
+		if (it == merged.end()) {
+			merged.push_back(result);
+			continue;
+		}
+
+		// ӵĸػϲ൱ڰβӣʱӣƽָɺϲ slowdown ¼
+		SimStats& stats = it->stats;
+		const SimStats& other = result.stats;
+		stats.now += other.now;
+		stats.busy_time += other.busy_time;
+		stats.events += other.events;
+		stats.dispatches += other.dispatches;
+		stats.context_switches += other.context_switches;
+		stats.switch_time += other.switch_time;
+		stats.finished += other.finished;
+		stats.total_turnaround += other.total_turnaround;
+		stats.total_waiting += other.total_waiting;
+		stats.total_response += other.total_response;
+		stats.total_slowdown += other.total_slowdown;
+		stats.total_slowdown_sq += other.total_slowdown_sq;
+		stats.io_requests += other.io_requests;
+		stats.io_busy_time += other.io_busy_time;
+		stats.blocked_time += other.blocked_time;
+		it->fairness = stats.fairness();
+		it->seeds++;
+		it->latency.merge(result.latency);
+		it->wall_seconds += result.wall_seconds;
+	}
+	return merged;
+}
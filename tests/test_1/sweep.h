@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "workload.h"
+
+// 񣬸άѿÿһζģ
+struct SweepGrid {
+	std::vector<std::string> policies = { "priority" };
+	std::vector<uint32_t> seeds = { 1 };
+	std::vector<double_t> quanta = { 4 };
+	std::vector<size_t> process_counts = { 1000 };
+	std::vector<double_t> io_bound = { 0 };  //I/O ͽ̵ı
+	double_t mean_gap = 3;  //ƽ
+	IoMix io;               //I/O ͽ̵Ĳio_bound ȡά
+	SimConfig sim;          //Ϲõл
+	// Ԥʱ> 0 ʱͬһ (policy, processes, io_bound, seed) ֻõһʱƬģһ [0, warmup)
+	// ɿգʱƬ϶ݿշֲٸظԤ
+	double_t warmup = 0;
+};
+
+struct SweepResult {
+	std::string policy;
+	uint32_t seed = 0;
+	double_t quantum = 0;
+	size_t processes = 0;
+	double_t io_bound = 0;
+	SimStats stats;
+	LatencyHistograms latency;
+	double_t fairness = 1;
+	double_t wall_seconds = 0;  //ԤʱõԤȲ
+	size_t seeds = 1;  //merge_seeds ϲ
+	std::string error; //ǿձʾûܳɣʶնصȣͳЧ
+
+	bool ok() const { return error.empty(); }
+};
+
+// ÿΪһͶ̳߳أ֮䲻ɱ״̬дԵĲλ
+// threads Ϊ 0 ʱӲ߳˳У߳޹ء
+// Ͷǰͳһ飬ʶϲģ⣻ʧԭдڸԵ error У÷Ӧ ok()
+std::vector<SweepResult> run_sweep(const SweepGrid& grid, size_t threads = 0);
+
+// ͬһ (policy, quantum, processes, io_bound) ²ͬӵĽϲһУܺӣֱͼͰϲ
+// λӵĽ̺һķλǸӷλƽseed ȡһӡ
+// ʧܵĽϲ
+std::vector<SweepResult> merge_seeds(const std::vector<SweepResult>& results);
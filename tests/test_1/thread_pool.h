@@ -0,0 +1,74 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ̶߳أsubmit Ͷwait ȵͶݵȫ
+class ThreadPool {
+public:
+	explicit ThreadPool(size_t threads = 0) {
+		if (threads == 0) threads = std::thread::hardware_concurrency();
+		if (threads == 0) threads = 1;
+		for (size_t i = 0; i < threads; ++i) workers.emplace_back([this] { work(); });
+	}
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		task_ready.notify_all();
+		for (auto& worker : workers) worker.join();
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	size_t size() const { return workers.size(); }
+
+	void submit(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push_back(std::move(task));
+			pending++;
+		}
+		task_ready.notify_one();
+	}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		all_done.wait(lock, [this] { return pending == 0; });
+	}
+
+private:
+	void work() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				task_ready.wait(lock, [this] { return stop || !tasks.empty(); });
+				if (tasks.empty()) return;
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+
+			task();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--pending == 0) all_done.notify_all();
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable task_ready;
+	std::condition_variable all_done;
+	size_t pending = 0;
+	bool stop = false;
+};
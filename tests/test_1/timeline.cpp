@@ -0,0 +1,73 @@
+#include "timeline.h"
+
+#include <algorithm>
+
+void Timeline::clear() {
+	runs.clear();
+	lane_runs.clear();
+	last_of_lane.clear();
+	generation++;
+}
+
+void Timeline::add(int32_t lane, double start, double end) {
+	if (lane < 0 || end <= start) return;
+	if (static_cast<size_t>(lane) >= lane_runs.size()) {
+		lane_runs.resize(lane + 1);
+		last_of_lane.resize(lane + 1, -1);
+	}
+
+	// ڱһ֮мûбĽйӳһ
+	int64_t last = last_of_lane[lane];
+	if (last >= 0 && static_cast<size_t>(last) + 1 == runs.size() && runs[last].end >= start - 1e-9) {
+		runs[last].end = std::max(runs[last].end, end);
+		return;
+	}
+
+	last_of_lane[lane] = static_cast<int64_t>(runs.size());
+	lane_runs[lane].push_back(static_cast<uint32_t>(runs.size()));
+	runs.push_back(Run{ start, end, lane });
+}
+
+// ֻȫһλᱻ add ӳ source ǰ size() - 1 뱾ͬ
+void Timeline::sync(const Timeline& source) {
+	if (generation != source.generation || runs.size() > source.runs.size()) {
+		*this = source;
+		return;
+	}
+
+	if (!runs.empty()) runs.back().end = source.runs[runs.size() - 1].end;
+	if (lane_runs.size() < source.lane_runs.size()) {
+		lane_runs.resize(source.lane_runs.size());
+		last_of_lane.resize(source.last_of_lane.size(), -1);
+	}
+	for (size_t i = runs.size(); i < source.runs.size(); ++i) {
+		const Run& run = source.runs[i];
+		last_of_lane[run.lane] = static_cast<int64_t>(i);
+		lane_runs[run.lane].push_back(static_cast<uint32_t>(i));
+		runs.push_back(run);
+	}
+}
+
+const std::vector<uint32_t>* Timeline::lane_index(int32_t lane) const {
+	if (lane < 0 || static_cast<size_t>(lane) >= lane_runs.size()) return nullptr;
+	return &lane_runs[lane];
+}
+
+size_t Timeline::first_ending_after(const std::vector<uint32_t>* index, double t) const {
+	size_t lo = 0, hi = count_of(index);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (end_of(index, mid) > t) hi = mid;
+		else lo = mid + 1;
+	}
+	return lo;
+}
+
+int64_t Timeline::find(int32_t lane, double t) const {
+	const std::vector<uint32_t>* index = lane_index(lane);
+	if (lane >= 0 && !index) return -1;
+
+	size_t i = first_ending_after(index, t);
+	if (i >= count_of(index) || start_of(index, i) > t) return -1;
+	return index ? (*index)[i] : static_cast<int64_t>(i);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// ִʷͼݣϸлصʱȺ
+// ͬһβӵĶκϲһΣʱƬתصͬһ̲¼
+class Timeline {
+public:
+	struct Run {
+		double start = 0;
+		double end = 0;
+		int32_t lane = 0; // process_list е±
+	};
+
+	void clear();
+	void add(int32_t lane, double start, double end);
+
+	// ñ source һ¡source ϴͬû clear ʱֻ׷ĶΡ¿ܱӳһΣ
+	// Ķȣ帴
+	void sync(const Timeline& source);
+
+	size_t size() const { return runs.size(); }
+	size_t lanes() const { return lane_runs.size(); }
+	double end_time() const { return runs.empty() ? 0 : runs.back().end; }
+	const Run& run(size_t i) const { return runs[i]; }
+
+	// ϸڲβü [t0, t1) ֳ columns УĳһÿһһͼԪ
+	// һиǶʱһЩеľΣһＷ˶ʱֻһռеľΣ
+	// öһУԴ O(columns * log n)ܶ޹ء
+	// emit(start, end) Ҫ䣻lane < 0 ʾн̻ͬһУCPU ͼ
+	template <typename F>
+	size_t for_each_visible(int32_t lane, double t0, double t1, int columns, F&& emit) const;
+
+	//  lane Ұʱ t жΣûз -1
+	int64_t find(int32_t lane, double t) const;
+
+private:
+	const std::vector<uint32_t>* lane_index(int32_t lane) const;
+	double start_of(const std::vector<uint32_t>* index, size_t i) const { return runs[index ? (*index)[i] : i].start; }
+	double end_of(const std::vector<uint32_t>* index, size_t i) const { return runs[index ? (*index)[i] : i].end; }
+	size_t count_of(const std::vector<uint32_t>* index) const { return index ? index->size() : runs.size(); }
+	size_t first_ending_after(const std::vector<uint32_t>* index, double t) const; //һ end > t Ķ
+
+	std::vector<Run> runs;                        //ʱ
+	std::vector<std::vector<uint32_t>> lane_runs; //ÿ̵Ķ runs еλãҲʱ
+	std::vector<int64_t> last_of_lane;            //һΣںϲ
+	uint64_t generation = 0;                      //clear Ĵsync ݴжܷ׷
+};
+
+template <typename F>
+size_t Timeline::for_each_visible(int32_t lane, double t0, double t1, int columns, F&& emit) const {
+	const std::vector<uint32_t>* index = lane_index(lane);
+	if ((lane >= 0 && !index) || columns <= 0 || t1 <= t0) return 0;
+
+	double width = (t1 - t0) / columns;
+	size_t n = count_of(index);
+	size_t i = first_ending_after(index, t0);
+	size_t emitted = 0;
+	double drawn = t0; //ѻλãͼԪ֮ʼ֤ÿһͼԪ
+	while (i < n) {
+		double start = std::max(start_of(index, i), drawn);
+		if (start >= t1) break;
+
+		double end = end_of(index, i);
+		if (end <= start) {
+			i++;
+			continue;
+		}
+
+		// βڵбĶΣһʣµĲһ𻭳һΣٶһУ
+		// ÿͼԪһµпʼ
+		double column_end = t0 + std::ceil((end - t0) / width) * width;
+		if (i + 1 < n && start_of(index, i + 1) < column_end) {
+			size_t next = first_ending_after(index, column_end);
+			drawn = next < n && start_of(index, next) < column_end ? column_end : end_of(index, next - 1);
+			i = next;
+		}
+		else {
+			drawn = end;
+			i++;
+		}
+		emit(start, drawn);
+		emitted++;
+	}
+	return emitted;
+}
@@ -0,0 +1,247 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const uint64_t WINDOW_SIZE = uint64_t(64) << 20; //ÿӳ 64MB
+
+static uint64_t allocation_granularity() {
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwAllocationGranularity;
+#else
+	return static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+bool TraceWriter::open(const std::string& path) {
+	close();
+	file = std::fopen(path.c_str(), "wb");
+	if (!file) {
+		std::cerr << "Failed to create trace: " << path << std::endl;
+		return false;
+	}
+
+	header = TraceHeader();
+	header.record_size = sizeof(TraceRecord);
+	last_arrival = -std::numeric_limits<double_t>::infinity(); //ĵʱҲǺϷ
+	return std::fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+bool TraceWriter::add(const TraceRecord& record) {
+	if (!file || record.arrival < last_arrival) return false;
+
+	last_arrival = record.arrival;
+	header.count++;
+	return std::fwrite(&record, sizeof(record), 1, file) == 1;
+}
+
+bool TraceWriter::close() {
+	if (!file) return true;
+
+	bool ok = std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+	ok = std::fclose(file) == 0 && ok;
+	file = nullptr;
+	return ok;
+}
+
+static TraceRecord to_record(const PCB& process) {
+	TraceRecord record;
+	record.pid = process.pid;
+	record.priority = process.priority;
+	record.arrival = process.arrival;
+	record.burst = process.burst;
+	record.io_every = static_cast<float>(process.io_every);
+	record.io_time = static_cast<float>(process.io_time);
+	record.device = process.device;
+	return record;
+}
+
+bool write_trace(const std::string& path, const std::vector<PCB>& process_list) {
+	std::vector<const PCB*> order;
+	order.reserve(process_list.size());
+	for (const auto& process : process_list) order.push_back(&process);
+	std::stable_sort(order.begin(), order.end(), [](const PCB* a, const PCB* b) { return a->arrival < b->arrival; });
+
+	TraceWriter writer;
+	if (!writer.open(path)) return false;
+	for (const PCB* process : order) {
+		if (!writer.add(to_record(*process))) return false;
+	}
+	return writer.close();
+}
+
+bool write_trace(const std::string& path, WorkloadSource& source) {
+	TraceWriter writer;
+	if (!writer.open(path)) return false;
+	PCB process(0, 0, 0, 0, State::R);
+	while (source.next(process)) {
+		if (!writer.add(to_record(process))) return false;
+	}
+	return writer.close();
+}
+
+bool write_random_trace(const std::string& path, uint64_t n, uint32_t seed, double_t mean_gap) {
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<> dist_priority(1, 5);
+	std::uniform_int_distribution<> dist_time(1, 5);
+	std::exponential_distribution<> dist_gap(mean_gap > 0 ? 1.0 / mean_gap : 1.0);
+
+	TraceWriter writer;
+	if (!writer.open(path)) return false;
+	TraceRecord record;
+	for (uint64_t i = 0; i < n; ++i) {
+		record.pid = static_cast<int32_t>(i + 1);
+		record.priority = dist_priority(gen);
+		record.burst = dist_time(gen);
+		if (!writer.add(record)) return false;
+		if (mean_gap > 0) record.arrival += std::floor(dist_gap(gen));
+	}
+	return writer.close();
+}
+
+MappedTrace::~MappedTrace() {
+	close();
+}
+
+bool MappedTrace::open(const std::string& path) {
+	close();
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		std::cerr << "Failed to open trace: " << path << std::endl;
+		return false;
+	}
+	LARGE_INTEGER size;
+	GetFileSizeEx(file, &size);
+	file_size = static_cast<uint64_t>(size.QuadPart);
+	HANDLE mapping = file_size > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+	file_handle = file;
+	mapping_handle = mapping;
+	if (!mapping) {
+		std::cerr << "Failed to map trace: " << path << std::endl;
+		close();
+		return false;
+	}
+#else
+	fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		std::cerr << "Failed to open trace: " << path << std::endl;
+		return false;
+	}
+	struct stat st;
+	fstat(fd, &st);
+	file_size = static_cast<uint64_t>(st.st_size);
+#endif
+
+	if (file_size < sizeof(TraceHeader) || !map_window(0)) {
+		std::cerr << "Not a trace file: " << path << std::endl;
+		close();
+		return false;
+	}
+
+	std::memcpy(&header, view, sizeof(header));
+	if (std::memcmp(header.magic, TraceHeader().magic, sizeof(header.magic)) != 0 || header.version != 1 ||
+		header.record_size != sizeof(TraceRecord) ||
+		file_size < sizeof(TraceHeader) + header.count * sizeof(TraceRecord)) {
+		std::cerr << "Not a trace file or truncated: " << path << std::endl;
+		close();
+		return false;
+	}
+
+	cursor = 0;
+	return true;
+}
+
+void MappedTrace::close() {
+	unmap_window();
+#if defined(_WIN32)
+	if (mapping_handle) CloseHandle(mapping_handle);
+	if (file_handle) CloseHandle(file_handle);
+	mapping_handle = file_handle = nullptr;
+#else
+	if (fd >= 0) ::close(fd);
+	fd = -1;
+#endif
+	header = TraceHeader();
+	file_size = 0;
+	cursor = 0;
+}
+
+bool MappedTrace::map_window(uint64_t offset) {
+	unmap_window();
+
+	uint64_t granularity = allocation_granularity();
+	view_offset = offset / granularity * granularity;
+	view_size = std::min(WINDOW_SIZE, file_size - view_offset);
+
+#if defined(_WIN32)
+	view = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ,
+		static_cast<DWORD>(view_offset >> 32), static_cast<DWORD>(view_offset & 0xffffffff), static_cast<SIZE_T>(view_size)));
+	if (!view) return false;
+#else
+	void* p = mmap(nullptr, view_size, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(view_offset));
+	if (p == MAP_FAILED) return false;
+	madvise(p, view_size, MADV_SEQUENTIAL);
+	view = static_cast<const char*>(p);
+#endif
+	return true;
+}
+
+void MappedTrace::unmap_window() {
+	if (!view) return;
+#if defined(_WIN32)
+	UnmapViewOfFile(view);
+#else
+	munmap(const_cast<char*>(view), view_size);
+#endif
+	view = nullptr;
+	view_size = 0;
+}
+
+bool MappedTrace::next(TraceRecord& record) {
+	if (cursor >= header.count) return false;
+
+	uint64_t offset = sizeof(TraceHeader) + cursor * sizeof(TraceRecord);
+	if (!view || offset < view_offset || offset + sizeof(TraceRecord) > view_offset + view_size) {
+		if (!map_window(offset)) return false;
+	}
+
+	std::memcpy(&record, view + (offset - view_offset), sizeof(record));
+	cursor++;
+	return true;
+}
+
+bool MappedTrace::skip(uint64_t n) {
+	if (n > header.count - cursor) return false;
+	cursor += n;
+	return true;
+}
+
+bool MappedTrace::next(PCB& process) {
+	TraceRecord record;
+	if (!next(record)) return false;
+
+	process = PCB(record.pid, record.priority, record.burst, 0, State::R, record.arrival);
+	process.io_every = record.io_every;
+	process.io_time = record.io_time;
+	process.device = record.device;
+	return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "pcb.h"
+
+// Ƹ traceһļͷӶ¼¼ʱС
+// ļͷ count  TraceWriter::close ʱ
+struct TraceHeader {
+	char magic[8] = { 'O', 'S', 'T', 'R', 'A', 'C', 'E', '\0' };
+	uint32_t version = 1;
+	uint32_t record_size = 0;
+	uint64_t count = 0;
+};
+
+struct TraceRecord {
+	double_t arrival = 0;
+	double_t burst = 0;
+	float io_every = 0;      //ÿж÷һ I/O0 ʾ CPU 
+	float io_time = 0;       //ÿ I/O ƽʱ
+	int32_t pid = 0;
+	int32_t priority = 0;
+	int32_t device = 0;      //I/O 豸
+	uint32_t reserved = 0;
+};
+
+static_assert(sizeof(TraceHeader) == 24, "TraceHeader layout");
+static_assert(sizeof(TraceRecord) == 40, "TraceRecord layout");
+
+// ˳д traceڴб¼
+class TraceWriter {
+public:
+	~TraceWriter() { close(); }
+
+	bool open(const std::string& path);
+	bool add(const TraceRecord& record);  //ʱ벻
+	bool close();
+
+	uint64_t count() const { return header.count; }
+
+private:
+	std::FILE* file = nullptr;
+	TraceHeader header;
+	double_t last_arrival = -std::numeric_limits<double_t>::infinity();
+};
+
+bool write_trace(const std::string& path, const std::vector<PCB>& process_list);
+// ѸԴϳɸдڴб
+bool write_trace(const std::string& path, WorkloadSource& source);
+//  random_workload ֲͬɱдڴй̱
+bool write_random_trace(const std::string& path, uint64_t n, uint32_t seed, double_t mean_gap = 2);
+
+// ֻڴӳ traceÿֻӳļеһڣĩβӳһΣ
+// Դʮ¼ļҲ˲ɣռõĵַռڴ涼ļС޹ء
+class MappedTrace : public WorkloadSource {
+public:
+	MappedTrace() {}
+	~MappedTrace();
+
+	MappedTrace(const MappedTrace&) = delete;
+	MappedTrace& operator=(const MappedTrace&) = delete;
+
+	bool open(const std::string& path);
+	void close();
+
+	size_t size() const override { return static_cast<size_t>(header.count); }
+	bool next(PCB& process) override;
+	bool next(TraceRecord& record);
+	bool skip(uint64_t n) override; //ֻƶλã´ next ʱӳڵĴ
+
+	uint64_t position() const { return cursor; }
+
+private:
+	bool map_window(uint64_t offset);
+	void unmap_window();
+
+	TraceHeader header;
+	uint64_t file_size = 0;
+	uint64_t cursor = 0;        //һ¼
+
+	const char* view = nullptr; //ǰ
+	uint64_t view_offset = 0;   //ļе㣨ȶ룩
+	uint64_t view_size = 0;
+
+#if defined(_WIN32)
+	void* file_handle = nullptr;
+	void* mapping_handle = nullptr;
+#else
+	int fd = -1;
+#endif
+};
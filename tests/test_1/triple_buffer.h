@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// дջ塣дԼĻд publishм仺彻
+// ʱԼĻм仺彻˫Զռһ壬мһֻһԭӽݣ
+// дߴӲȶߡҲӲдߣȡߵмջᱻµĸǡ
+template <typename T>
+class TripleBuffer {
+public:
+	T& write_buffer() { return slots[back]; }
+
+	void publish() {
+		back = middle.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX;
+	}
+
+	// ȡ·Ŀգû¿ʱһζ
+	const T& read() {
+		if (middle.load(std::memory_order_relaxed) & FRESH) {
+			front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+		}
+		return slots[front];
+	}
+
+private:
+	static constexpr uint8_t INDEX = 3;
+	static constexpr uint8_t FRESH = 4;
+
+	T slots[3];
+	uint8_t back = 0;                //д߶ռ
+	std::atomic<uint8_t> middle{ 1 };
+	uint8_t front = 2;               //߶ռ
+};
@@ -0,0 +1,88 @@
+#include "workload.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+bool load_workload(const std::string& path, std::vector<PCB>& process_list) {
+	std::ifstream in(path);
+	if (!in) {
+		std::cerr << "Failed to open workload: " << path << std::endl;
+		return false;
+	}
+
+	process_list.clear();
+	std::string line;
+	size_t line_no = 0;
+	while (std::getline(in, line)) {
+		line_no++;
+		size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#') continue;
+
+		std::istringstream fields(line);
+		int32_t pid, priority;
+		double_t burst, arrival = 0;
+		if (!(fields >> pid >> priority >> burst) || burst <= 0) {
+			std::cerr << path << ":" << line_no << ": expected \"pid priority burst [arrival [io_every io_time [device]]]\"" << std::endl;
+			return false;
+		}
+		fields >> arrival;
+		PCB process(pid, priority, burst, 0, State::R, arrival);
+		if (fields >> process.io_every) {
+			if (!(fields >> process.io_time) || process.io_every < 0 || process.io_time < 0) {
+				std::cerr << path << ":" << line_no << ": io_every must be followed by io_time" << std::endl;
+				return false;
+			}
+			fields >> process.device;
+		}
+		process_list.push_back(process);
+	}
+
+	return true;
+}
+
+bool save_workload(const std::string& path, const std::vector<PCB>& process_list) {
+	std::ofstream out(path);
+	if (!out) {
+		std::cerr << "Failed to create workload: " << path << std::endl;
+		return false;
+	}
+
+	out << "# pid priority burst arrival [io_every io_time device]\n";
+	for (const auto& process : process_list) {
+		out << process.pid << " " << process.priority << " " << process.burst << " " << process.arrival;
+		if (process.io_every > 0) out << " " << process.io_every << " " << process.io_time << " " << process.device;
+		out << "\n";
+	}
+	return true;
+}
+
+std::vector<PCB> random_workload(size_t n, uint32_t seed, double_t mean_gap) {
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<> dist_priority(1, 5);
+	std::uniform_int_distribution<> dist_time(1, 5);
+	std::exponential_distribution<> dist_gap(mean_gap > 0 ? 1.0 / mean_gap : 1.0);
+
+	std::vector<PCB> process_list;
+	process_list.reserve(n);
+	double_t arrival = 0;
+	for (size_t i = 0; i < n; ++i) {
+		process_list.emplace_back(static_cast<int32_t>(i + 1), dist_priority(gen), dist_time(gen), 0, State::R, arrival);
+		if (mean_gap > 0) arrival += std::floor(dist_gap(gen));
+	}
+	return process_list;
+}
+
+void assign_io(std::vector<PCB>& process_list, const IoMix& mix, uint32_t seed) {
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<> coin(0, 1);
+	std::uniform_int_distribution<> dist_device(0, std::max(mix.devices, 1) - 1);
+	for (auto& process : process_list) {
+		if (coin(gen) >= mix.io_bound) continue;
+		process.io_every = mix.io_every;
+		process.io_time = mix.io_time;
+		process.device = dist_device(gen);
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pcb.h"
+
+// ıļÿ "pid priority burst [arrival [io_every io_time [device]]]"# ͷΪע
+bool load_workload(const std::string& path, std::vector<PCB>& process_list);
+bool save_workload(const std::string& path, const std::vector<PCB>& process_list);
+
+// ͼνĳʼͬķֲȼͷʱ䶼 1~5 ȷֲ
+// Ϊֵ mean_gap ֲָȡmean_gap <= 0 ʱȫ 0 ʱ̵
+std::vector<PCB> random_workload(size_t n, uint32_t seed, double_t mean_gap = 0);
+
+// CPU  I/O ͽ̵Ļϱ
+struct IoMix {
+	double_t io_bound = 0;  //I/O ͽ̵ı
+	double_t io_every = 1;  //I/O ͽÿж÷һ I/O
+	double_t io_time = 4;   //ÿ I/O ƽʱ
+	int32_t devices = 1;    //I/O ͽ̾ȷֵô豸
+};
+
+//  mix  I/O ͽ̲ǵ I/O ִ̱ CPU 
+void assign_io(std::vector<PCB>& process_list, const IoMix& mix, uint32_t seed);
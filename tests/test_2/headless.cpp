@@ -0,0 +1,119 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../common/cli.h"
+#include "../common/report.h"
+#include "memory.h"
+
+using namespace std;
+
+static void usage() {
+    cerr << "usage: test_2_headless --workload FILE [--policy first|best|worst] [--memory SIZE]"
+        " [--resume SNAPSHOT] [--checkpoint SNAPSHOT] [--format csv|json] [--output FILE]" << endl;
+    cerr << "workload lines: \"alloc NAME SIZE\" or \"free NAME\"" << endl;
+    cerr << "--resume starts from a saved memory state instead of one free block (--policy still applies);"
+        " --checkpoint saves the state after the workload" << endl;
+}
+
+int main(int argc, char** argv) {
+    CommandLine args(argc, argv);
+    if (!args.has("workload")) {
+        usage();
+        return -1;
+    }
+
+    Report::Format format = Report::CSV;
+    if (!Report::parse_format(args.get("format", "csv"), format)) {
+        usage();
+        return -1;
+    }
+
+    string policy = args.get("policy", "first");
+    if (policy == "first") current_method = FIRST_FIT;
+    else if (policy == "best") current_method = BEST_FIT;
+    else if (policy == "worst") current_method = WORST_FIT;
+    else {
+        cerr << "Unknown policy: " << policy << endl;
+        usage();
+        return -1;
+    }
+
+    ifstream in(args.get("workload"));
+    if (!in) {
+        cerr << "Failed to open workload: " << args.get("workload") << endl;
+        return -1;
+    }
+
+    int memory = static_cast<int>(args.get_number("memory", 1500));
+    memory_log = false;
+    free_list.clear();
+    allocated_list.clear();
+    if (args.has("resume")) {
+        AllocationMethod method = current_method;
+        if (!load_memory_snapshot(args.get("resume"))) return -1;
+        current_method = method;
+        memory = free_memory();
+        for (const auto& a : allocated_list) memory += a.length;
+    }
+    else {
+        free_list.emplace_back(0, memory, "Free");
+    }
+
+    size_t requests = 0, allocated = 0, failed = 0, recycled = 0;
+    int peak_used = memory - free_memory();
+    double fragmentation_sum = 0;
+    string line;
+    size_t line_no = 0;
+    while (getline(in, line)) {
+        line_no++;
+        istringstream fields(line);
+        string op, name;
+        if (!(fields >> op) || op[0] == '#') continue;
+
+        if (op == "alloc") {
+            int length;
+            if (!(fields >> name >> length) || length <= 0) {
+                cerr << args.get("workload") << ":" << line_no << ": expected \"alloc NAME SIZE\"" << endl;
+                return -1;
+            }
+            if (allocate_main_memory(length, name)) allocated++;
+            else failed++;
+        }
+        else if (op == "free") {
+            if (!(fields >> name)) {
+                cerr << args.get("workload") << ":" << line_no << ": expected \"free NAME\"" << endl;
+                return -1;
+            }
+            if (recycle_main_memory(name)) recycled++;
+        }
+        else {
+            cerr << args.get("workload") << ":" << line_no << ": unknown operation " << op << endl;
+            return -1;
+        }
+
+        requests++;
+        peak_used = max(peak_used, memory - free_memory());
+        fragmentation_sum += external_fragmentation();
+    }
+
+    if (args.has("checkpoint") && !save_memory_snapshot(args.get("checkpoint"))) return -1;
+
+    Report report;
+    report.begin_row();
+    report.add("policy", policy);
+    report.add("memory", memory);
+    report.add("requests", requests);
+    report.add("allocated", allocated);
+    report.add("failed", failed);
+    report.add("recycled", recycled);
+    report.add("peak_used", peak_used);
+    report.add("free", free_memory());
+    report.add("holes", free_list.size());
+    report.add("largest_free_block", largest_free_block());
+    report.add("fragmentation", external_fragmentation());
+    report.add("avg_fragmentation", requests ? fragmentation_sum / requests : 0.0);
+
+    return report.save(args.get("output"), format) ? 0 : -1;
+}
@@ -13,117 +13,9 @@
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
 
-using namespace std;
-
-class FreeAreaTable {
-public:
-    int start;     //ʼַ
-    int length;    //С
-    string status; //״̬
-
-    FreeAreaTable(int start, int length, string status) : start(start), length(length), status(status) {}
-};
-
-class AllocatedTable {
-public:
-    int start;   //ʼַ
-    int length;  //С
-    string name; //
-
-    AllocatedTable(int start, int length, string name) : start(start), length(length), name(name) {}
-};
-
-vector<FreeAreaTable> free_list;
-vector<AllocatedTable> allocated_list;
+#include "memory.h"
 
-enum AllocationMethod { FIRST_FIT, BEST_FIT, WORST_FIT };
-AllocationMethod current_method = FIRST_FIT;
-
-void merge_free_area() {
-    if (free_list.empty()) return;
-
-    // Sort by start address for proper merging
-    sort(free_list.begin(), free_list.end(), [](const FreeAreaTable& a, const FreeAreaTable& b) {
-        return a.start < b.start;
-        });
-
-    // Merge adjacent free blocks
-    for (auto it = free_list.begin(); it != free_list.end() && next(it) != free_list.end(); ) {
-        auto next_it = next(it);
-        if (it->start + it->length == next_it->start) {
-            it->length += next_it->length;
-            free_list.erase(next_it);
-        }
-        else {
-            ++it;
-        }
-    }
-}
-
-void allocate_main_memory(int length, string name) {
-    if (free_list.empty()) {
-        cout << "No free memory available." << endl;
-        return;
-    }
-
-    auto it = free_list.end();
-
-    // Find the appropriate free block based on the allocation method
-    switch (current_method) {
-    case FIRST_FIT:
-        it = find_if(free_list.begin(), free_list.end(), [length](const FreeAreaTable& block) {
-            return block.length >= length;
-            });
-        break;
-
-    case BEST_FIT:
-        it = min_element(free_list.begin(), free_list.end(), [length](const FreeAreaTable& a, const FreeAreaTable& b) {
-            return (a.length >= length && (a.length < b.length || b.length < length));
-            });
-        break;
-
-    case WORST_FIT:
-        it = max_element(free_list.begin(), free_list.end(), [length](const FreeAreaTable& a, const FreeAreaTable& b) {
-            return a.length < b.length;
-            });
-        if (it != free_list.end() && it->length < length) it = free_list.end(); // Check if a valid block is found
-        break;
-    }
-
-    if (it == free_list.end() || it->length < length) {
-        cout << "No suitable free memory block found." << endl;
-        return;
-    }
-
-    int start = it->start;
-    if (it->length == length) {
-        free_list.erase(it); // Remove the block if fully allocated
-    }
-    else {
-        it->start += length;
-        it->length -= length; // Adjust block size and position
-    }
-
-    allocated_list.emplace_back(start, length, name);
-    cout << "Memory Allocated: " << name << " at " << start << " with size " << length << endl;
-}
-
-void recycle_main_memory(string name) {
-    auto it = find_if(allocated_list.begin(), allocated_list.end(), [name](const AllocatedTable& block) {
-        return block.name == name;
-        });
-
-    if (it == allocated_list.end()) {
-        cout << "No allocated memory block found with name: " << name << endl;
-        return;
-    }
-
-    free_list.emplace_back(it->start, it->length, "Free");
-    allocated_list.erase(it);
-
-    merge_free_area();
-    cout << "Memory Recycled: " << name << endl;
-}
+using namespace std;
 
 void draw_memory_visualization() {
     float width = 800.0f;  // Visualization width
@@ -184,6 +76,38 @@ void show_main_memory() {
         recycle_main_memory("Process A");
     }
 
+    ImGui::Spacing();
+
+    // 浽Ŀ¼µĿļ´Դŷ
+    if (ImGui::Button("Save Snapshot")) {
+        save_memory_snapshot("memory.snap");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Load Snapshot") && load_memory_snapshot("memory.snap")) {
+        method = static_cast<int>(current_method);
+        memory_history->reset();
+    }
+
+    ImGui::Spacing();
+
+    // ϶صһη/֮״̬ؿʱٷջᶪ֮ʷ
+    uint64_t position = memory_history->position();
+    uint64_t first = memory_history->begin();
+    uint64_t last = max(memory_history->size(), first + 1);
+    ImGui::SetNextItemWidth(400);
+    if (ImGui::SliderScalar("History", ImGuiDataType_U64, &position, &first, &last)) {
+        memory_history->seek(min(position, memory_history->size()));
+    }
+    ImGui::SameLine();
+    ImGui::Text("%llu / %llu", static_cast<unsigned long long>(memory_history->position()),
+        static_cast<unsigned long long>(memory_history->size()));
+    uint64_t shown = memory_history->position() > first ? min<uint64_t>(memory_history->position() - first, 8) : 0;
+    for (uint64_t i = memory_history->position(); i-- > memory_history->position() - shown; ) {
+        const MemoryOp& op = memory_history->at(i);
+        ImGui::Text("#%llu\t%s %s\tat %d size %d", static_cast<unsigned long long>(i), op.recycle ? "free " : "alloc",
+            op.name, op.start, op.length);
+    }
+
     ImGui::End();
 }
 
@@ -215,6 +139,9 @@ int main() {
     ImGui::StyleColorsDark();
 
     free_list.emplace_back(0, 1500, "Free");
+    MemoryHistory history;
+    history.reset();
+    memory_history = &history;
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
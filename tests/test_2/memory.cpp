@@ -0,0 +1,276 @@
+#include "memory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+vector<FreeAreaTable> free_list;
+vector<AllocatedTable> allocated_list;
+
+AllocationMethod current_method = FIRST_FIT;
+bool memory_log = true;
+MemoryHistory* memory_history = nullptr;
+
+static void record_op(int32_t recycle, int start, int length, const string& name) {
+    if (!memory_history) return;
+    MemoryOp op;
+    op.recycle = recycle;
+    op.start = start;
+    op.length = length;
+    strncpy(op.name, name.c_str(), sizeof(op.name) - 1);
+    memory_history->record(op);
+}
+
+void merge_free_area() {
+    if (free_list.empty()) return;
+
+    // Sort by start address for proper merging
+    sort(free_list.begin(), free_list.end(), [](const FreeAreaTable& a, const FreeAreaTable& b) {
+        return a.start < b.start;
+        });
+
+    // Merge adjacent free blocks
+    for (auto it = free_list.begin(); it != free_list.end() && next(it) != free_list.end(); ) {
+        auto next_it = next(it);
+        if (it->start + it->length == next_it->start) {
+            it->length += next_it->length;
+            free_list.erase(next_it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+bool allocate_main_memory(int length, string name) {
+    if (free_list.empty()) {
+        if (memory_log) cout << "No free memory available." << endl;
+        return false;
+    }
+
+    auto it = free_list.end();
+
+    // Find the appropriate free block based on the allocation method
+    switch (current_method) {
+    case FIRST_FIT:
+        it = find_if(free_list.begin(), free_list.end(), [length](const FreeAreaTable& block) {
+            return block.length >= length;
+            });
+        break;
+
+    case BEST_FIT:
+        it = min_element(free_list.begin(), free_list.end(), [length](const FreeAreaTable& a, const FreeAreaTable& b) {
+            return (a.length >= length && (a.length < b.length || b.length < length));
+            });
+        break;
+
+    case WORST_FIT:
+        it = max_element(free_list.begin(), free_list.end(), [length](const FreeAreaTable& a, const FreeAreaTable& b) {
+            return a.length < b.length;
+            });
+        if (it != free_list.end() && it->length < length) it = free_list.end(); // Check if a valid block is found
+        break;
+    }
+
+    if (it == free_list.end() || it->length < length) {
+        if (memory_log) cout << "No suitable free memory block found." << endl;
+        return false;
+    }
+
+    int start = it->start;
+    if (it->length == length) {
+        free_list.erase(it); // Remove the block if fully allocated
+    }
+    else {
+        it->start += length;
+        it->length -= length; // Adjust block size and position
+    }
+
+    allocated_list.emplace_back(start, length, name);
+    record_op(0, start, length, name);
+    if (memory_log) cout << "Memory Allocated: " << name << " at " << start << " with size " << length << endl;
+    return true;
+}
+
+bool recycle_main_memory(string name) {
+    auto it = find_if(allocated_list.begin(), allocated_list.end(), [name](const AllocatedTable& block) {
+        return block.name == name;
+        });
+
+    if (it == allocated_list.end()) {
+        if (memory_log) cout << "No allocated memory block found with name: " << name << endl;
+        return false;
+    }
+
+    int start = it->start, length = it->length;
+    free_list.emplace_back(start, length, "Free");
+    allocated_list.erase(it);
+
+    merge_free_area();
+    record_op(1, start, length, name); //ؼ֡ڻ֮
+    if (memory_log) cout << "Memory Recycled: " << name << endl;
+    return true;
+}
+
+void save_memory(SnapshotWriter& out) {
+    out.put(static_cast<int32_t>(current_method));
+    out.put(free_list.size());
+    for (const auto& f : free_list) {
+        out.put(f.start);
+        out.put(f.length);
+        out.put_string(f.status);
+    }
+    out.put(allocated_list.size());
+    for (const auto& a : allocated_list) {
+        out.put(a.start);
+        out.put(a.length);
+        out.put_string(a.name);
+    }
+}
+
+bool load_memory(SnapshotReader& in) {
+    int32_t method = 0;
+    if (!in.get(method) || method < FIRST_FIT || method > WORST_FIT) return in.fail();
+
+    vector<FreeAreaTable> free_blocks;
+    size_t count = 0;
+    in.get(count);
+    for (size_t i = 0; i < count && in.ok(); ++i) {
+        int start = 0, length = 0;
+        string status;
+        in.get(start);
+        in.get(length);
+        in.get_string(status);
+        free_blocks.emplace_back(start, length, status);
+    }
+
+    vector<AllocatedTable> allocated_blocks;
+    in.get(count);
+    for (size_t i = 0; i < count && in.ok(); ++i) {
+        int start = 0, length = 0;
+        string name;
+        in.get(start);
+        in.get(length);
+        in.get_string(name);
+        allocated_blocks.emplace_back(start, length, name);
+    }
+    if (!in.ok()) return false;
+
+    current_method = static_cast<AllocationMethod>(method);
+    free_list.swap(free_blocks);
+    allocated_list.swap(allocated_blocks);
+    return true;
+}
+
+bool save_memory_snapshot(const string& path) {
+    SnapshotWriter out(SNAPSHOT_MEMORY);
+    save_memory(out);
+    return out.save(path);
+}
+
+bool load_memory_snapshot(const string& path) {
+    MappedSnapshot file;
+    if (!file.open(path)) return false;
+    SnapshotReader in(file.data(), file.size(), SNAPSHOT_MEMORY);
+    if (!load_memory(in)) {
+        cerr << "Not a memory snapshot or truncated: " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+void MemoryHistory::reset() {
+    ops.clear();
+    keyframes.clear();
+    current = 0;
+    save_memory(keyframes.begin(0, 0));
+    keyframes.end();
+}
+
+void MemoryHistory::record(const MemoryOp& op) {
+    if (current < ops.size()) {
+        ops.truncate(current);
+        keyframes.truncate(current);
+    }
+    ops.push(op);
+    current++;
+    // ؼ֮֡ǰĲܱǣÿһ
+    const Keyframe* last = keyframes.newest();
+    if (keyframes.due(current) || !last || current - last->index >= ops.capacity() / 2) {
+        save_memory(keyframes.begin(current, static_cast<double>(current)));
+        keyframes.end();
+    }
+}
+
+uint64_t MemoryHistory::begin() const {
+    // ؼ֮֡Ĳڻܴط
+    for (const Keyframe* k = keyframes.oldest(); k && k <= keyframes.newest(); ++k) {
+        if (k->index >= ops.first()) return k->index;
+    }
+    return size();
+}
+
+// طһ¼Ǵӿпг԰ʼַҵʱõĿп
+static bool replay_op(const MemoryOp& op) {
+    if (op.recycle) {
+        auto it = find_if(allocated_list.begin(), allocated_list.end(), [&op](const AllocatedTable& block) {
+            return block.start == op.start;
+            });
+        if (it == allocated_list.end()) return false;
+        free_list.emplace_back(it->start, it->length, "Free");
+        allocated_list.erase(it);
+        merge_free_area();
+        return true;
+    }
+
+    auto it = find_if(free_list.begin(), free_list.end(), [&op](const FreeAreaTable& block) {
+        return block.start == op.start && block.length >= op.length;
+        });
+    if (it == free_list.end()) return false;
+    if (it->length == op.length) {
+        free_list.erase(it);
+    }
+    else {
+        it->start += op.length;
+        it->length -= op.length;
+    }
+    allocated_list.emplace_back(op.start, op.length, op.name);
+    return true;
+}
+
+bool MemoryHistory::seek(uint64_t index) {
+    if (index < begin() || index > size()) return false;
+    const Keyframe* frame = keyframes.at_or_before(index);
+    SnapshotReader in = keyframes.open(*frame);
+    AllocationMethod method = current_method; //㷨ǽϵãʷ
+    bool loaded = load_memory(in);
+    current_method = method;
+    if (!loaded) return false;
+    for (uint64_t i = frame->index; i < index; ++i) {
+        if (!replay_op(ops.at(i))) {
+            cerr << "Memory history replay diverged at op " << i << endl;
+            return false;
+        }
+    }
+    current = index;
+    return true;
+}
+
+int free_memory() {
+    int total = 0;
+    for (const auto& f : free_list) total += f.length;
+    return total;
+}
+
+int largest_free_block() {
+    int largest = 0;
+    for (const auto& f : free_list) largest = max(largest, f.length);
+    return largest;
+}
+
+double external_fragmentation() {
+    int total = free_memory();
+    return total > 0 ? 1.0 - static_cast<double>(largest_free_block()) / total : 0.0;
+}
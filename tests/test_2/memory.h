@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../common/replay.h"
+#include "../common/snapshot.h"
+
+class FreeAreaTable {
+public:
+    int start;          //ʼַ
+    int length;         //С
+    std::string status; //״̬
+
+    FreeAreaTable(int start, int length, std::string status) : start(start), length(length), status(status) {}
+};
+
+class AllocatedTable {
+public:
+    int start;        //ʼַ
+    int length;       //С
+    std::string name; //
+
+    AllocatedTable(int start, int length, std::string name) : start(start), length(length), name(name) {}
+};
+
+extern std::vector<FreeAreaTable> free_list;
+extern std::vector<AllocatedTable> allocated_list;
+
+enum AllocationMethod { FIRST_FIT, BEST_FIT, WORST_FIT };
+extern AllocationMethod current_method;
+extern bool memory_log; //Ƿڿ̨ӡ/־
+
+void merge_free_area();
+bool allocate_main_memory(int length, std::string name);
+bool recycle_main_memory(std::string name);
+
+// գбѷ͵ǰ㷨ʱ滻⼸ȫֱʧʱǱԭ
+void save_memory(SnapshotWriter& out);
+bool load_memory(SnapshotReader& in);
+bool save_memory_snapshot(const std::string& path);
+bool load_memory_snapshot(const std::string& path);
+
+// һγɹķաطʱ¼ʼַԭִУ뵱ʱõ㷨޹أ
+// ֻǰ 47 ֽڣؿŲʱƻᱻض
+struct MemoryOp {
+    int32_t recycle = 0; //0 䣬1 
+    int32_t start = 0;
+    int32_t length = 0;
+    int32_t reserved = 0;
+    char name[48] = {};
+};
+
+static_assert(sizeof(MemoryOp) == 64, "MemoryOp layout");
+
+// ʷÿγɹķ/׷һ MemoryOpʱԤؼ֡ؼ֮֡Ĳ
+// seek ֮ǰĹؼ֡طŵһдȫֵĿбѷؿٷ/ջᶪ֮ʷ
+class MemoryHistory {
+public:
+    explicit MemoryHistory(size_t capacity = size_t(1) << 16) : ops(capacity) {}
+
+    void reset();                 //Եǰڴ״̬Ϊ¼¼
+    void record(const MemoryOp& op);
+    bool seek(uint64_t index);    //ص index ֮״̬
+
+    uint64_t position() const { return current; }
+    uint64_t size() const { return ops.size(); }
+    uint64_t begin() const;       //ܻصλ
+    const MemoryOp& at(uint64_t index) const { return ops.at(index); } //begin() <= index < size()
+
+private:
+    EventRing<MemoryOp> ops;
+    KeyframeStore keyframes{ SNAPSHOT_MEMORY };
+    uint64_t current = 0;
+};
+
+extern MemoryHistory* memory_history; //ǿʱ¼ͻ
+
+int free_memory();                //
+int largest_free_block();
+double external_fragmentation();  //1 - п / 
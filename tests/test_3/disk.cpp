@@ -0,0 +1,105 @@
+#include "disk.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+
+std::vector<int> FCFS(const std::vector<int>& request) {
+    return request;
+}
+
+std::vector<int> SSTF(const std::vector<int>& request) {
+    std::vector<int> result;
+    std::vector<bool> visited(request.size(), false);
+    int current = request[0];
+    result.push_back(current);
+
+    for (size_t i = 1; i < request.size(); ++i) {
+        int closest_index = -1;
+        int min_distance = std::numeric_limits<int>::max();
+
+        for (size_t j = 0; j < request.size(); ++j) {
+            if (!visited[j] && std::abs(request[j] - current) < min_distance) {
+                closest_index = j;
+                min_distance = std::abs(request[j] - current);
+            }
+        }
+
+        if (closest_index != -1) {
+            visited[closest_index] = true;
+            current = request[closest_index];
+            result.push_back(current);
+        }
+    }
+
+    return result;
+}
+
+std::vector<int> SCAN(const std::vector<int>& request) {
+    std::vector<int> result = request;
+    std::sort(result.begin(), result.end());
+
+    int start = request[0];
+    auto it = std::lower_bound(result.begin(), result.end(), start);
+    std::vector<int> scan_result;
+
+    for (auto iter = it; iter != result.end(); ++iter) {
+        scan_result.push_back(*iter);
+    }
+
+    if (it != result.begin()) {
+        for (auto riter = std::make_reverse_iterator(it); riter != result.rend(); ++riter) {
+            scan_result.push_back(*riter);
+        }
+    }
+
+    return scan_result;
+}
+
+std::vector<int> CSCAN(const std::vector<int>& request) {
+    std::vector<int> result = request;
+    std::sort(result.begin(), result.end());
+
+    int start = request[0];
+    auto it = std::lower_bound(result.begin(), result.end(), start);
+    std::vector<int> cscan_result;
+
+    for (auto iter = it; iter != result.end(); ++iter) {
+        cscan_result.push_back(*iter);
+    }
+
+    for (auto iter = result.begin(); iter != it; ++iter) {
+        cscan_result.push_back(*iter);
+    }
+
+    return cscan_result;
+}
+
+std::vector<int> NStepSCAN(const std::vector<int>& request, int step) {
+    std::vector<int> result = request;
+    std::sort(result.begin(), result.end());
+    std::vector<int> nstepscan_result;
+
+    for (size_t i = 0; i < result.size(); i += step) {
+        auto begin = result.begin() + i;
+        auto end = (i + step < result.size()) ? begin + step : result.end();
+        nstepscan_result.insert(nstepscan_result.end(), begin, end);
+    }
+
+    return nstepscan_result;
+}
+
+// Ѱ
+int calculate_seek_distance(const std::vector<int>& result) {
+    int total_distance = 0;
+    for (size_t i = 1; i < result.size(); ++i) {
+        total_distance += std::abs(result[i] - result[i - 1]);
+    }
+    return total_distance;
+}
+
+// ƽѰ
+float calculate_average_seek_distance(int total_distance, int num_requests) {
+    return static_cast<float>(total_distance) / (num_requests - 1);
+}
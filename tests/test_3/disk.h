@@ -0,0 +1,18 @@
+#pragma once
+
+#include <vector>
+
+#define TRACK_REQUEST_COUNT 10 // Ĵŵ
+#define TRACK_MAX_COUNT 100    // ŵ
+
+std::vector<int> FCFS(const std::vector<int>& request);
+std::vector<int> SSTF(const std::vector<int>& request);
+std::vector<int> SCAN(const std::vector<int>& request);
+std::vector<int> CSCAN(const std::vector<int>& request);
+std::vector<int> NStepSCAN(const std::vector<int>& request, int step = 10);
+
+// Ѱ
+int calculate_seek_distance(const std::vector<int>& result);
+
+// ƽѰ
+float calculate_average_seek_distance(int total_distance, int num_requests);
@@ -0,0 +1,86 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../common/cli.h"
+#include "../common/report.h"
+#include "disk.h"
+
+static void usage() {
+    std::cerr << "usage: test_3_headless --workload FILE [--policy fcfs|sstf|scan|cscan|nstepscan|all]"
+        " [--step N] [--format csv|json] [--output FILE]" << std::endl;
+    std::cerr << "workload: whitespace separated track numbers, the first one is the initial head position" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    CommandLine args(argc, argv);
+    if (!args.has("workload")) {
+        usage();
+        return -1;
+    }
+
+    Report::Format format = Report::CSV;
+    if (!Report::parse_format(args.get("format", "csv"), format)) {
+        usage();
+        return -1;
+    }
+
+    std::ifstream in(args.get("workload"));
+    if (!in) {
+        std::cerr << "Failed to open workload: " << args.get("workload") << std::endl;
+        return -1;
+    }
+
+    std::vector<int> track_request;
+    int track;
+    while (in >> track) track_request.push_back(track);
+    if (track_request.size() < 2) {
+        std::cerr << "Workload needs at least two track numbers" << std::endl;
+        return -1;
+    }
+
+    std::string policy = args.get("policy", "all");
+    double step_value = args.get_number("step", 10);
+    if (!(step_value >= 1)) {
+        // ÿһ󣬷 N-Step-SCAN ޷ǰ
+        std::cerr << "--step must be at least 1" << std::endl;
+        usage();
+        return -1;
+    }
+    int step = static_cast<int>(step_value);
+
+    struct Algorithm {
+        const char* name;
+        std::vector<int>(*run)(const std::vector<int>&);
+    };
+    const Algorithm algorithms[] = {
+        { "fcfs", FCFS },
+        { "sstf", SSTF },
+        { "scan", SCAN },
+        { "cscan", CSCAN },
+        { "nstepscan", nullptr },
+    };
+
+    Report report;
+    for (const auto& algorithm : algorithms) {
+        if (policy != "all" && policy != algorithm.name) continue;
+
+        std::vector<int> result = algorithm.run ? algorithm.run(track_request) : NStepSCAN(track_request, step);
+        int total_distance = calculate_seek_distance(result);
+
+        report.begin_row();
+        report.add("policy", algorithm.name);
+        report.add("requests", track_request.size());
+        report.add("total_seek", total_distance);
+        report.add("avg_seek", calculate_average_seek_distance(total_distance, static_cast<int>(result.size())));
+    }
+
+    if (report.empty()) {
+        std::cerr << "Unknown policy: " << policy << std::endl;
+        usage();
+        return -1;
+    }
+
+    return report.save(args.get("output"), format) ? 0 : -1;
+}
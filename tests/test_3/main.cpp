@@ -1,7 +1,6 @@
 #include <vector>
 #include <iostream>
 #include <string>
-#include <unordered_map>
 #include <algorithm>
 
 #include <glad/glad.h>
@@ -12,108 +11,28 @@
 #include <imgui/imgui_impl_opengl3.h>
 #include <imgui/implot.h> //չ
 
-#define TRACK_REQUEST_COUNT 10 // Ĵŵ
-#define TRACK_MAX_COUNT 100    // ŵ
+#include "disk.h"
 
-std::unordered_map<std::string, float> list(5);
-
-std::vector<int> FCFS(const std::vector<int>& request) {
-    return request;
-}
-
-std::vector<int> SSTF(const std::vector<int>& request) {
-    std::vector<int> result;
-    std::vector<bool> visited(request.size(), false);
-    int current = request[0];
-    result.push_back(current);
-
-    for (size_t i = 1; i < request.size(); ++i) {
-        int closest_index = -1;
-        int min_distance = TRACK_MAX_COUNT + 1;
-
-        for (size_t j = 0; j < request.size(); ++j) {
-            if (!visited[j] && std::abs(request[j] - current) < min_distance) {
-                closest_index = j;
-                min_distance = std::abs(request[j] - current);
-            }
-        }
-
-        if (closest_index != -1) {
-            visited[closest_index] = true;
-            current = request[closest_index];
-            result.push_back(current);
-        }
-    }
-
-    return result;
-}
-
-std::vector<int> SCAN(const std::vector<int>& request) {
-    std::vector<int> result = request;
-    std::sort(result.begin(), result.end());
-
-    int start = request[0];
-    auto it = std::lower_bound(result.begin(), result.end(), start);
-    std::vector<int> scan_result;
-
-    for (auto iter = it; iter != result.end(); ++iter) {
-        scan_result.push_back(*iter);
-    }
-
-    if (it != result.begin()) {
-        for (auto riter = std::make_reverse_iterator(it); riter != result.rend(); ++riter) {
-            scan_result.push_back(*riter);
-        }
-    }
-
-    return scan_result;
-}
-
-std::vector<int> CSCAN(const std::vector<int>& request) {
-    std::vector<int> result = request;
-    std::sort(result.begin(), result.end());
-
-    int start = request[0];
-    auto it = std::lower_bound(result.begin(), result.end(), start);
-    std::vector<int> cscan_result;
-
-    for (auto iter = it; iter != result.end(); ++iter) {
-        cscan_result.push_back(*iter);
-    }
-
-    for (auto iter = result.begin(); iter != it; ++iter) {
-        cscan_result.push_back(*iter);
-    }
-
-    return cscan_result;
-}
-
-std::vector<int> NStepSCAN(const std::vector<int>& request, int step = 10) {
-    std::vector<int> result = request;
-    std::sort(result.begin(), result.end());
-    std::vector<int> nstepscan_result;
-
-    for (size_t i = 0; i < result.size(); i += step) {
-        auto begin = result.begin() + i;
-        auto end = (i + step < result.size()) ? begin + step : result.end();
-        nstepscan_result.insert(nstepscan_result.end(), begin, end);
-    }
-
-    return nstepscan_result;
-}
-
-// Ѱ
-int calculate_seek_distance(const std::vector<int>& result) {
+// ÿ㷨ĽѰͳֻʱһΣȾʱֱȡ
+struct AlgorithmResult {
+    std::string name;
+    std::vector<int> order;        //˳
+    std::vector<int> access_order; //0, 1, 2 ... Ϊ
     int total_distance = 0;
-    for (size_t i = 1; i < result.size(); ++i) {
-        total_distance += std::abs(result[i] - result[i - 1]);
-    }
-    return total_distance;
-}
-
-// ƽѰ
-float calculate_average_seek_distance(int total_distance, int num_requests) {
-    return static_cast<float>(total_distance) / (num_requests - 1);
+    float avg_distance = 0;
+};
+
+AlgorithmResult make_result(const std::string& name, std::vector<int> order) {
+    AlgorithmResult result;
+    result.name = name;
+    result.order = std::move(order);
+    result.access_order.resize(result.order.size());
+    for (int i = 0; i < static_cast<int>(result.order.size()); ++i) {
+        result.access_order[i] = i;
+    }
+    result.total_distance = calculate_seek_distance(result.order);
+    result.avg_distance = calculate_average_seek_distance(result.total_distance, result.order.size());
+    return result;
 }
 
 GLFWwindow* setup_window() {
@@ -138,6 +57,7 @@ GLFWwindow* setup_window() {
 
     // õǰΪ˴
     glfwMakeContextCurrent(window);
+    glfwSwapInterval(1); // ֱͬ
 
     // ʼ glad
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
@@ -172,11 +92,8 @@ void cleanup_imgui() {
 }
 
 void render_imgui_with_chart(const std::vector<int>& track_request,
-    const std::vector<int>& fcfs_result,
-    const std::vector<int>& sstf_result,
-    const std::vector<int>& scan_result,
-    const std::vector<int>& cscan_result,
-    const std::vector<int>& nstepscan_result) {
+    const std::vector<AlgorithmResult>& results,
+    const std::vector<const AlgorithmResult*>& ranking) {
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
@@ -190,48 +107,22 @@ void render_imgui_with_chart(const std::vector<int>& track_request,
     }
     ImGui::NewLine();
 
-    static std::string current_algorithm = "FCFS";
-    if (ImGui::Button("FCFS")) current_algorithm = "FCFS";
-    ImGui::SameLine();
-    if (ImGui::Button("SSTF")) current_algorithm = "SSTF";
-    ImGui::SameLine();
-    if (ImGui::Button("SCAN")) current_algorithm = "SCAN";
-    ImGui::SameLine();
-    if (ImGui::Button("CSCAN")) current_algorithm = "CSCAN";
-    ImGui::SameLine();
-    if (ImGui::Button("NStepSCAN")) current_algorithm = "NStepSCAN";
-
-    const std::vector<int>* result = nullptr;
-    if (current_algorithm == "FCFS") result = &fcfs_result;
-    else if (current_algorithm == "SSTF") result = &sstf_result;
-    else if (current_algorithm == "SCAN") result = &scan_result;
-    else if (current_algorithm == "CSCAN") result = &cscan_result;
-    else if (current_algorithm == "NStepSCAN") result = &nstepscan_result;
-
-    std::vector<int> access_order(result->size());
-    for (int i = 0; i < result->size(); ++i) {
-        access_order[i] = i;
+    static size_t current_algorithm = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (i > 0) ImGui::SameLine();
+        if (ImGui::Button(results[i].name.c_str())) current_algorithm = i;
     }
-    
-    // ѰЧ
-    int total_distance = calculate_seek_distance(*result);
-    float avg_distance = calculate_average_seek_distance(total_distance, result->size());
+    const AlgorithmResult* result = &results[current_algorithm];
 
     // ʾѰЧ
-    ImGui::Text("Total Seek Distance: %d", total_distance);
-    ImGui::Text("Average Seek Distance: %.2f", avg_distance);
+    ImGui::Text("Total Seek Distance: %d", result->total_distance);
+    ImGui::Text("Average Seek Distance: %.2f", result->avg_distance);
 
     // ƽѰ
-    list[current_algorithm] = avg_distance;
-    std::vector<std::pair<std::string, float>> sorted_list(list.begin(), list.end());
-    std::sort(sorted_list.begin(), sorted_list.end(), 
-        [](const std::pair<std::string, float>& a, const std::pair<std::string, float>& b) {
-            return a.second < b.second;
-        });
     ImGui::Text("Algorithm Performance Sorted by Average Seek Distanc: ");
     ImGui::SameLine();
-    for (auto algorithm : sorted_list) {
-        ImGui::Text("%s ", algorithm.first.c_str());
+    for (const AlgorithmResult* algorithm : ranking) {
+        ImGui::Text("%s ", algorithm->name.c_str());
         ImGui::SameLine();
     }
     ImGui::NewLine();
@@ -245,13 +136,13 @@ void render_imgui_with_chart(const std::vector<int>& track_request,
             ImPlot::SetupAxis(ImAxis_Y1, "Access Order", ImPlotAxisFlags_Invert);
 
             // ӱ
-            ImPlot::SetupAxesLimits(0, 100, 0, (int)result->size());
+            ImPlot::SetupAxesLimits(0, 100, 0, (int)result->order.size());
             ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.25f);
-            ImPlot::PlotShaded("Background", result->data(), access_order.data(), result->size());
+            ImPlot::PlotShaded("Background", result->order.data(), result->access_order.data(), result->order.size());
             ImPlot::PopStyleVar();
 
             // ͼ
-            ImPlot::PlotLine("Track Access", result->data(), access_order.data(), result->size());
+            ImPlot::PlotLine("Track Access", result->order.data(), result->access_order.data(), result->order.size());
             ImPlot::EndPlot();
         }
     }
@@ -274,22 +165,25 @@ int main() {
         track = rand() % TRACK_MAX_COUNT;
     }
 
-    std::vector<int> fcfs_result = FCFS(track_request);
-    std::vector<int> sstf_result = SSTF(track_request);
-    std::vector<int> scan_result = SCAN(track_request);
-    std::vector<int> cscan_result = CSCAN(track_request);
-    std::vector<int> nstepscan_result = NStepSCAN(track_request);
+    std::vector<AlgorithmResult> results;
+    results.push_back(make_result("FCFS", FCFS(track_request)));
+    results.push_back(make_result("SSTF", SSTF(track_request)));
+    results.push_back(make_result("SCAN", SCAN(track_request)));
+    results.push_back(make_result("CSCAN", CSCAN(track_request)));
+    results.push_back(make_result("NStepSCAN", NStepSCAN(track_request)));
+
+    std::vector<const AlgorithmResult*> ranking;
+    for (const auto& result : results) ranking.push_back(&result);
+    std::stable_sort(ranking.begin(), ranking.end(), [](const AlgorithmResult* a, const AlgorithmResult* b) {
+        return a->avg_distance < b->avg_distance;
+        });
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        render_imgui_with_chart(track_request, fcfs_result, 
-            sstf_result, 
-            scan_result, 
-            cscan_result, 
-            nstepscan_result);
+        render_imgui_with_chart(track_request, results, ranking);
 
         glfwSwapBuffers(window);
     }